@@ -32,12 +32,50 @@ namespace MINI_STL
 	*/
 	/************************************************************************/
 	template <class ForwardIterator,class T>
-	void fill(ForwardIterator first,ForwardIterator last,const T& value)
+	inline void fill(ForwardIterator first,ForwardIterator last,const T& value)
+	{
+		typedef typename segmented_iterator_traits<ForwardIterator>::is_segmented_iterator is_segmented;
+		_fill_segmented(first,last,value,is_segmented());
+	}
+
+	//单字节类型直接memset
+	inline void fill(char* first,char* last,const char& value)
+	{
+		memset(first,static_cast<unsigned char>(value),last-first);
+	}
+
+	inline void fill(unsigned char* first,unsigned char* last,const unsigned char& value)
+	{
+		memset(first,value,last-first);
+	}
+
+	template <class ForwardIterator,class T>
+	inline void _fill_segmented(ForwardIterator first,ForwardIterator last,const T& value,_false_type)
 	{
 		for(;first!=last;++first)
 			*first=value;
 	}
 
+	//分段迭代器逐块填充,块内为原生指针
+	template <class SegmentedIterator,class T>
+	void _fill_segmented(SegmentedIterator first,SegmentedIterator last,const T& value,_true_type)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		typename traits::segment_iterator sfirst = traits::segment(first);
+		typename traits::segment_iterator slast = traits::segment(last);
+		if (sfirst==slast)
+		{
+			MINI_STL::fill(traits::local(first),traits::local(last),value);
+			return;
+		}
+		MINI_STL::fill(traits::local(first),traits::end(sfirst),value);
+		for (++sfirst; sfirst!=slast; ++sfirst)
+		{
+			MINI_STL::fill(traits::begin(sfirst),traits::end(sfirst),value);
+		}
+		MINI_STL::fill(traits::begin(slast),traits::local(last),value);
+	}
+
 	template <class OutputIterator ,class Size,class T>
 	OutputIterator fill_n(OutputIterator first,Size n,const T& value)
 	{
@@ -74,7 +112,9 @@ namespace MINI_STL
 	{
 		OutputIterator operator()(InputIterator first,InputIterator last,OutputIterator dest)
 		{
-			return _copy(first,last,dest,iterator_category(first));
+			typedef typename segmented_iterator_traits<InputIterator>::is_segmented_iterator in_segmented;
+			typedef typename segmented_iterator_traits<OutputIterator>::is_segmented_iterator out_segmented;
+			return _copy_segmented(first,last,dest,in_segmented(),out_segmented());
 		}
 	};
 
@@ -98,6 +138,73 @@ namespace MINI_STL
 		}
 	};
 
+	//源与目的均非分段迭代器
+	template<class InputIterator,class OutputIterator>
+	inline OutputIterator _copy_segmented(InputIterator first,InputIterator last,OutputIterator dest,_false_type,_false_type)
+	{
+		return _copy(first,last,dest,iterator_category(first));
+	}
+
+	//源为分段迭代器:逐块取出原生指针区间再copy
+	template<class SegmentedIterator,class OutputIterator,class OutSegmented>
+	OutputIterator _copy_segmented(SegmentedIterator first,SegmentedIterator last,OutputIterator dest,_true_type,OutSegmented)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		typename traits::segment_iterator sfirst = traits::segment(first);
+		typename traits::segment_iterator slast = traits::segment(last);
+		if (sfirst==slast)
+		{
+			return MINI_STL::copy(traits::local(first),traits::local(last),dest);
+		}
+		dest = MINI_STL::copy(traits::local(first),traits::end(sfirst),dest);
+		for (++sfirst; sfirst!=slast; ++sfirst)
+		{
+			dest = MINI_STL::copy(traits::begin(sfirst),traits::end(sfirst),dest);
+		}
+		return MINI_STL::copy(traits::begin(slast),traits::local(last),dest);
+	}
+
+	//目的为分段迭代器:按目的块切分源区间
+	template<class InputIterator,class SegmentedIterator>
+	inline SegmentedIterator _copy_segmented(InputIterator first,InputIterator last,SegmentedIterator dest,_false_type,_true_type)
+	{
+		return _copy_to_segmented(first,last,dest,iterator_category(first));
+	}
+
+	template<class InputIterator,class SegmentedIterator>
+	SegmentedIterator _copy_to_segmented(InputIterator first,InputIterator last,SegmentedIterator dest,input_iterator_tag)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		while (first!=last)
+		{
+			typename traits::segment_iterator seg = traits::segment(dest);
+			typename traits::local_iterator cur = traits::local(dest);
+			typename traits::local_iterator end = traits::end(seg);
+			for (; first!=last && cur!=end; ++first,++cur)
+				*cur = *first;
+			dest = traits::compose(seg,cur);
+		}
+		return dest;
+	}
+
+	template<class RandomAccessIterator,class SegmentedIterator>
+	SegmentedIterator _copy_to_segmented(RandomAccessIterator first,RandomAccessIterator last,SegmentedIterator dest,random_access_iterator_tag)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		ptrdiff_t n = last-first;
+		while (n>0)
+		{
+			typename traits::segment_iterator seg = traits::segment(dest);
+			typename traits::local_iterator cur = traits::local(dest);
+			const ptrdiff_t len = MINI_STL::min(n,ptrdiff_t(traits::end(seg)-cur));
+			cur = MINI_STL::copy(first,first+len,cur);
+			first += len;
+			n -= len;
+			dest = traits::compose(seg,cur);
+		}
+		return dest;
+	}
+
 	//_copy的InputIterator和RandomAccessIterator版本
 	template<class InputIterator,class OutputIterator>
 	inline OutputIterator _copy(InputIterator first,InputIterator last,OutputIterator dest,input_iterator_tag)
@@ -167,10 +274,104 @@ namespace MINI_STL
 
 	template <class BidirectionalIterator1,class BidirectionalIterator2>
 	inline BidirectionalIterator2 copy_backward(BidirectionalIterator1 first,BidirectionalIterator1 last,BidirectionalIterator2 dest)
+	{
+		typedef typename segmented_iterator_traits<BidirectionalIterator1>::is_segmented_iterator in_segmented;
+		typedef typename segmented_iterator_traits<BidirectionalIterator2>::is_segmented_iterator out_segmented;
+		return _copy_backward_segmented(first,last,dest,in_segmented(),out_segmented());
+	}
+
+	//T*和const T*特化版本所用到的_copy_backward_t
+	template<class T>
+	inline T* _copy_backward_t(const T *first,const T *last,T *dest,_true_type)
+	{
+		const ptrdiff_t n = last-first;
+		memmove(dest-n,first,sizeof(T)*n);
+		return dest-n;
+	}
+
+	template<class T>
+	inline T* _copy_backward_t(const T *first,const T *last,T *dest,_false_type)
+	{
+		return _copy_backward(first,last,dest,random_access_iterator_tag(),(ptrdiff_t*)0);
+	}
+
+	//copy_backward的T*和const T*版本,trivial赋值的类型直接memmove
+	template<class T>
+	inline T* copy_backward(T *first,T *last,T *dest)
+	{
+		typedef typename _type_traits<T>::has_trivial_assignment_operator t;
+		return _copy_backward_t<T>(first,last,dest,t());
+	}
+
+	template<class T>
+	inline T* copy_backward(const T *first,const T *last,T *dest)
+	{
+		typedef typename _type_traits<T>::has_trivial_assignment_operator t;
+		return _copy_backward_t<T>(first,last,dest,t());
+	}
+
+	//源与目的均非分段迭代器
+	template <class BidirectionalIterator1,class BidirectionalIterator2>
+	inline BidirectionalIterator2 _copy_backward_segmented(BidirectionalIterator1 first,BidirectionalIterator1 last,BidirectionalIterator2 dest,_false_type,_false_type)
 	{
 		return _copy_backward(first,last,dest,iterator_category(first),difference_type(first));
 	}
 
+	//源为分段迭代器:从最后一块开始逐块copy_backward
+	template <class SegmentedIterator,class BidirectionalIterator,class OutSegmented>
+	BidirectionalIterator _copy_backward_segmented(SegmentedIterator first,SegmentedIterator last,BidirectionalIterator dest,_true_type,OutSegmented)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		typename traits::segment_iterator sfirst = traits::segment(first);
+		typename traits::segment_iterator slast = traits::segment(last);
+		if (sfirst==slast)
+		{
+			return MINI_STL::copy_backward(traits::local(first),traits::local(last),dest);
+		}
+		dest = MINI_STL::copy_backward(traits::begin(slast),traits::local(last),dest);
+		for (--slast; slast!=sfirst; --slast)
+		{
+			dest = MINI_STL::copy_backward(traits::begin(slast),traits::end(slast),dest);
+		}
+		return MINI_STL::copy_backward(traits::local(first),traits::end(sfirst),dest);
+	}
+
+	//目的为分段迭代器:按目的块从后往前切分源区间
+	template <class BidirectionalIterator,class SegmentedIterator>
+	inline SegmentedIterator _copy_backward_segmented(BidirectionalIterator first,BidirectionalIterator last,SegmentedIterator dest,_false_type,_true_type)
+	{
+		return _copy_backward_to_segmented(first,last,dest,iterator_category(first));
+	}
+
+	template <class BidirectionalIterator,class SegmentedIterator>
+	inline SegmentedIterator _copy_backward_to_segmented(BidirectionalIterator first,BidirectionalIterator last,SegmentedIterator dest,bidirectional_iterator_tag)
+	{
+		return _copy_backward(first,last,dest,bidirectional_iterator_tag(),(ptrdiff_t*)0);
+	}
+
+	template <class RandomAccessIterator,class SegmentedIterator>
+	SegmentedIterator _copy_backward_to_segmented(RandomAccessIterator first,RandomAccessIterator last,SegmentedIterator dest,random_access_iterator_tag)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		ptrdiff_t n = last-first;
+		while (n>0)
+		{
+			typename traits::segment_iterator seg = traits::segment(dest);
+			typename traits::local_iterator cur = traits::local(dest);
+			if (cur==traits::begin(seg))
+			{
+				--seg;
+				cur = traits::end(seg);
+			}
+			const ptrdiff_t len = MINI_STL::min(n,ptrdiff_t(cur-traits::begin(seg)));
+			cur = MINI_STL::copy_backward(last-len,last,cur);
+			last -= len;
+			n -= len;
+			dest = traits::compose(seg,cur);
+		}
+		return dest;
+	}
+
 	/************************************************************************/
 	/* equal:[first1,last1)to[first2...)序列二中多的元素不予考虑
 	*/
@@ -223,6 +424,8 @@ namespace MINI_STL
 			{
 				return false;
 			}
+			++first1;
+			++first2;
 		}
 		return first1==last1&&first2!=last2;
 	}
@@ -242,6 +445,8 @@ namespace MINI_STL
 			{
 				return false;
 			}
+			++first1;
+			++first2;
 		}
 		return first1==last1&&first2!=last2;
 	}
@@ -268,8 +473,68 @@ namespace MINI_STL
 		return init;
 	}
 
+	/************************************************************************/
+	/* find:[first,last)中第一个等于value的位置
+		1.原生指针按4路展开比较
+		2.char指针交给memchr
+		3.分段迭代器逐块在原生指针上查找
+	*/
+	/************************************************************************/
 	template <class InputIterator,class T>
-	InputIterator find(InputIterator first,InputIterator last,const T& value)
+	inline InputIterator find(InputIterator first,InputIterator last,const T& value)
+	{
+		typedef typename segmented_iterator_traits<InputIterator>::is_segmented_iterator is_segmented;
+		return _find_segmented(first,last,value,is_segmented());
+	}
+
+	inline const char* find(const char* first,const char* last,const char& value)
+	{
+		const void* p = memchr(first,value,last-first);
+		return p ? static_cast<const char*>(p) : last;
+	}
+
+	inline char* find(char* first,char* last,const char& value)
+	{
+		void* p = memchr(first,value,last-first);
+		return p ? static_cast<char*>(p) : last;
+	}
+
+	//原生指针按4路展开比较
+	template <class T,class U>
+	T* find(T* first,T* last,const U& value)
+	{
+		for (ptrdiff_t trip = (last-first)>>2; trip>0; --trip)
+		{
+			if (*first==value) return first;
+			++first;
+			if (*first==value) return first;
+			++first;
+			if (*first==value) return first;
+			++first;
+			if (*first==value) return first;
+			++first;
+		}
+		switch (last-first)
+		{
+		case 3:
+			if (*first==value) return first;
+			++first;
+			//fallthrough
+		case 2:
+			if (*first==value) return first;
+			++first;
+			//fallthrough
+		case 1:
+			if (*first==value) return first;
+			++first;
+			//fallthrough
+		default:
+			return last;
+		}
+	}
+
+	template <class InputIterator,class T>
+	InputIterator _find_segmented(InputIterator first,InputIterator last,const T& value,_false_type)
 	{
 		while (first!=last && *first!=value)
 		{
@@ -278,6 +543,37 @@ namespace MINI_STL
 		return first;
 	}
 
+	template <class SegmentedIterator,class T>
+	SegmentedIterator _find_segmented(SegmentedIterator first,SegmentedIterator last,const T& value,_true_type)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		typedef typename traits::local_iterator local_iterator;
+		typename traits::segment_iterator sfirst = traits::segment(first);
+		typename traits::segment_iterator slast = traits::segment(last);
+		if (sfirst==slast)
+		{
+			local_iterator p = MINI_STL::find(traits::local(first),traits::local(last),value);
+			return p==traits::local(last) ? last : traits::compose(sfirst,p);
+		}
+		local_iterator end = traits::end(sfirst);
+		local_iterator p = MINI_STL::find(traits::local(first),end,value);
+		if (p!=end)
+		{
+			return traits::compose(sfirst,p);
+		}
+		for (++sfirst; sfirst!=slast; ++sfirst)
+		{
+			end = traits::end(sfirst);
+			p = MINI_STL::find(traits::begin(sfirst),end,value);
+			if (p!=end)
+			{
+				return traits::compose(sfirst,p);
+			}
+		}
+		p = MINI_STL::find(traits::begin(slast),traits::local(last),value);
+		return p==traits::local(last) ? last : traits::compose(slast,p);
+	}
+
 	template <class ForwardIterator,class T>
 	inline ForwardIterator lower_bound(ForwardIterator first,ForwardIterator last,const T& value)
 	{
@@ -48,6 +48,15 @@ namespace MINI_STL
 		static void *reallocate(void *p,size_t old_sz,size_t new_sz);
 	};
 
+	//直接使用malloc/free,线程安全;供多线程并发修改的容器代替alloc使用
+	class malloc_alloc
+	{
+	public:
+		static void *allocate(size_t n){return malloc(n);}
+		static void deallocate(void *p,size_t){free(p);}
+		static void *reallocate(void *p,size_t,size_t new_sz){return realloc(p,new_sz);}
+	};
+
 	
 
 	
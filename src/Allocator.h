@@ -5,7 +5,8 @@
 
 namespace MINI_STL
 {
-	template<class T>
+	//Alloc为底层的内存来源,默认是不加锁的内存池alloc
+	template<class T,class Alloc=alloc>
 	class Allocator
 	{
 	public:
@@ -23,26 +24,26 @@ namespace MINI_STL
 		static void deallocate(T *p, size_t n);				//回收n个T大小的内存
 	};
 
-	template<class T>
-	T *Allocator<T>::allocate(){
-		return static_cast<T *>(alloc::allocate(sizeof(T)));
+	template<class T,class Alloc>
+	T *Allocator<T,Alloc>::allocate(){
+		return static_cast<T *>(Alloc::allocate(sizeof(T)));
 	}
 
-	template<class T>
-	T *Allocator<T>::allocate(size_t n){
+	template<class T,class Alloc>
+	T *Allocator<T,Alloc>::allocate(size_t n){
 		if (n == 0) return 0;
-		return static_cast<T *>(alloc::allocate(sizeof(T) * n));
+		return static_cast<T *>(Alloc::allocate(sizeof(T) * n));
 	}
 
-	template<class T>
-	void Allocator<T>::deallocate(T *p){
-		alloc::deallocate(static_cast<void *>(p), sizeof(T));
+	template<class T,class Alloc>
+	void Allocator<T,Alloc>::deallocate(T *p){
+		Alloc::deallocate(static_cast<void *>(p), sizeof(T));
 	}
 
-	template<class T>
-	void Allocator<T>::deallocate(T *p, size_t n){
+	template<class T,class Alloc>
+	void Allocator<T,Alloc>::deallocate(T *p, size_t n){
 		if (n == 0) return;
-		alloc::deallocate(static_cast<void *>(p), sizeof(T)* n);
+		Alloc::deallocate(static_cast<void *>(p), sizeof(T)* n);
 	}
 }
 
@@ -0,0 +1,290 @@
+#ifndef _MINI_STL_CIRCULAR_BUFFER_H_
+#define _MINI_STL_CIRCULAR_BUFFER_H_
+
+#include "Algorithm.h"
+#include "Allocator.h"
+#include "Construct.h"
+#include "Iterator.h"
+#include "Uninitialized.h"
+
+namespace MINI_STL
+{
+	/************************************************************************/
+	/*	circular_buffer:环形缓冲区
+		1.元素存放在一块连续内存中,head为首元素位置,下标绕回开头
+		2.容量用尽时默认扩容为两倍;overwrite模式下容量固定(至少为1),push_back覆盖最旧的元素
+		3.容量稳定后push_back/pop_front不再申请内存
+		4.提供front/back/push_back/pop_front/pop_back,可作为queue和stack的Sequence
+	*/
+	/************************************************************************/
+	template<class Container,class Value>
+	struct circular_buffer_iterator
+	{
+		typedef random_access_iterator_tag	iterator_category;
+		typedef Value						value_type;
+		typedef Value*						pointer;
+		typedef Value&						reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+
+		Container* cb;
+		size_type index;
+
+		circular_buffer_iterator():cb(0),index(0){}
+		circular_buffer_iterator(Container* c,size_type i):cb(c),index(i){}
+		template<class C,class V>
+		circular_buffer_iterator(const circular_buffer_iterator<C,V>& x):cb(x.cb),index(x.index){}
+
+		reference operator*()const{return (*cb)[index];}
+		pointer operator->()const{return &(operator*());}
+
+		circular_buffer_iterator& operator++(){++index;return *this;}
+		circular_buffer_iterator operator++(int){auto temp = *this;++index;return temp;}
+		circular_buffer_iterator& operator--(){--index;return *this;}
+		circular_buffer_iterator operator--(int){auto temp = *this;--index;return temp;}
+		circular_buffer_iterator& operator+=(difference_type n){index += n;return *this;}
+		circular_buffer_iterator& operator-=(difference_type n){index -= n;return *this;}
+		circular_buffer_iterator operator+(difference_type n)const{return circular_buffer_iterator(cb,index+n);}
+		circular_buffer_iterator operator-(difference_type n)const{return circular_buffer_iterator(cb,index-n);}
+		difference_type operator-(const circular_buffer_iterator& x)const{return difference_type(index)-difference_type(x.index);}
+		reference operator[](difference_type n)const{return (*cb)[index+n];}
+
+		bool operator==(const circular_buffer_iterator& x)const{return index==x.index;}
+		bool operator!=(const circular_buffer_iterator& x)const{return index!=x.index;}
+		bool operator<(const circular_buffer_iterator& x)const{return index<x.index;}
+		bool operator>(const circular_buffer_iterator& x)const{return index>x.index;}
+		bool operator<=(const circular_buffer_iterator& x)const{return index<=x.index;}
+		bool operator>=(const circular_buffer_iterator& x)const{return index>=x.index;}
+	};
+
+	template<class T>
+	class circular_buffer
+	{
+	public:
+		typedef T							value_type;
+		typedef T*							pointer;
+		typedef const T*					const_pointer;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+
+		typedef circular_buffer_iterator<circular_buffer,T>				iterator;
+		typedef circular_buffer_iterator<const circular_buffer,const T>	const_iterator;
+
+	protected:
+		typedef Allocator<T> dataAllocator;
+
+		T* buffer;
+		size_type cap;
+		size_type head;         //首元素在buffer中的位置
+		size_type ele_nums;
+		bool overwrite;         //满时覆盖最旧的元素而不扩容
+
+		//逻辑下标i在buffer中的位置
+		size_type slot(size_type i)const
+		{
+			const size_type p = head+i;
+			return p<cap ? p : p-cap;
+		}
+
+		//按顺序把元素拷贝到dest开始的未初始化内存
+		void copy_elements(T* dest)const
+		{
+			if (buffer)
+			{
+				const size_type first_len = min(ele_nums,cap-head);
+				T* cur = Uninitialized_copy(buffer+head,buffer+head+first_len,dest);
+				Uninitialized_copy(buffer,buffer+(ele_nums-first_len),cur);
+			}
+		}
+
+		//换用新缓冲区,析构并释放旧的,head归零
+		void replace_buffer(T* new_buffer,size_type n)
+		{
+			destroy_elements();
+			deallocate();
+			buffer = new_buffer;
+			cap = n;
+			head = 0;
+		}
+
+		//按顺序把元素搬到大小为n的新缓冲区
+		void reallocate(size_type n)
+		{
+			T* new_buffer = dataAllocator::allocate(n);
+			copy_elements(new_buffer);
+			replace_buffer(new_buffer,n);
+		}
+
+		//满时扩容并在首/尾放入x;x在旧元素析构前构造,因此可以引用本容器中的元素
+		void grow_and_insert(const T& x,bool at_front)
+		{
+			const size_type n = cap ? 2*cap : 16;
+			T* new_buffer = dataAllocator::allocate(n);
+			copy_elements(at_front ? new_buffer+1 : new_buffer);
+			construct(at_front ? new_buffer : new_buffer+ele_nums,x);
+			replace_buffer(new_buffer,n);
+			++ele_nums;
+		}
+
+		void destroy_elements()
+		{
+			const size_type first_len = min(ele_nums,cap-head);
+			destroy(buffer+head,buffer+head+first_len);
+			destroy(buffer,buffer+(ele_nums-first_len));
+		}
+
+		void deallocate()
+		{
+			if (buffer)
+			{
+				dataAllocator::deallocate(buffer,cap);
+			}
+		}
+
+	public:
+		circular_buffer():buffer(0),cap(0),head(0),ele_nums(0),overwrite(false){}
+		//容量为n,overwrite为true时容量固定,n为0时按1处理
+		explicit circular_buffer(size_type n,bool overwrite_oldest=false)
+			:buffer(0),cap(0),head(0),ele_nums(0),overwrite(overwrite_oldest)
+		{
+			reserve((overwrite && n==0) ? 1 : n);
+		}
+		circular_buffer(const circular_buffer& x)
+			:buffer(0),cap(0),head(0),ele_nums(0),overwrite(x.overwrite)
+		{
+			reserve(x.cap);
+			for (const_iterator it = x.begin(); it != x.end(); ++it)
+			{
+				push_back(*it);
+			}
+		}
+		circular_buffer& operator=(const circular_buffer& x)
+		{
+			if (this!=&x)
+			{
+				circular_buffer temp(x);
+				swap(temp);
+			}
+			return *this;
+		}
+		~circular_buffer()
+		{
+			destroy_elements();
+			deallocate();
+		}
+
+		iterator begin(){return iterator(this,0);}
+		iterator end(){return iterator(this,ele_nums);}
+		const_iterator begin()const{return const_iterator(this,0);}
+		const_iterator end()const{return const_iterator(this,ele_nums);}
+
+		size_type size()const{return ele_nums;}
+		size_type capacity()const{return cap;}
+		bool empty()const{return ele_nums==0;}
+		bool full()const{return ele_nums==cap;}
+
+		reference operator[](size_type n){return buffer[slot(n)];}
+		const_reference operator[](size_type n)const{return buffer[slot(n)];}
+		reference front(){return buffer[head];}
+		const_reference front()const{return buffer[head];}
+		reference back(){return buffer[slot(ele_nums-1)];}
+		const_reference back()const{return buffer[slot(ele_nums-1)];}
+
+		void reserve(size_type n)
+		{
+			if (n>cap)
+			{
+				reallocate(n);
+			}
+		}
+
+		void push_back(const T& x)
+		{
+			if (ele_nums<cap)
+			{
+				construct(buffer+slot(ele_nums),x);
+				++ele_nums;
+			}
+			else if (overwrite)
+			{
+				buffer[head] = x;
+				head = slot(1);
+			}
+			else
+			{
+				grow_and_insert(x,false);
+			}
+		}
+
+		void push_front(const T& x)
+		{
+			if (ele_nums<cap)
+			{
+				head = head ? head-1 : cap-1;
+				construct(buffer+head,x);
+				++ele_nums;
+			}
+			else if (overwrite)
+			{
+				head = head ? head-1 : cap-1;
+				buffer[head] = x;
+			}
+			else
+			{
+				grow_and_insert(x,true);
+			}
+		}
+
+		void pop_front()
+		{
+			destroy(buffer+head);
+			head = slot(1);
+			--ele_nums;
+		}
+
+		void pop_back()
+		{
+			--ele_nums;
+			destroy(buffer+slot(ele_nums));
+		}
+
+		//析构全部元素,保留缓冲区
+		void clear()
+		{
+			destroy_elements();
+			head = 0;
+			ele_nums = 0;
+		}
+
+		void swap(circular_buffer& x)
+		{
+			MINI_STL::swap(buffer,x.buffer);
+			MINI_STL::swap(cap,x.cap);
+			MINI_STL::swap(head,x.head);
+			MINI_STL::swap(ele_nums,x.ele_nums);
+			MINI_STL::swap(overwrite,x.overwrite);
+		}
+	};
+
+	template<class T>
+	inline bool operator==(const circular_buffer<T>& x,const circular_buffer<T>& y)
+	{
+		return x.size()==y.size() && MINI_STL::equal(x.begin(),x.end(),y.begin());
+	}
+
+	template<class T>
+	inline bool operator!=(const circular_buffer<T>& x,const circular_buffer<T>& y)
+	{
+		return !(x==y);
+	}
+
+	template<class T>
+	inline bool operator<(const circular_buffer<T>& x,const circular_buffer<T>& y)
+	{
+		return MINI_STL::lexicographical_compare(x.begin(),x.end(),y.begin(),y.end());
+	}
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef _MINI_STL_CONCURRENT_HASH_MAP_H_
+#define _MINI_STL_CONCURRENT_HASH_MAP_H_
+
+#include <atomic>
+#include <climits>
+#include <thread>
+#include "Functional.h"
+#include "Hash_fcn.h"
+#include "HashTable.h"
+#include "Pair.h"
+#include "Spsc_queue.h"
+
+namespace MINI_STL
+{
+	/************************************************************************/
+	/*	shared_spin_lock:读写自旋锁
+		1.state最高位表示写者,其余位为读者数
+		2.写者先置写位阻止新的读者进入,再等已有的读者退出,写者不会饿死
+		3.等待时让出时间片,适合临界区很短(一次哈希表操作)的场合
+	*/
+	/************************************************************************/
+	class shared_spin_lock
+	{
+	private:
+		static const unsigned writer = 0x80000000u;
+		std::atomic<unsigned> state;
+
+		shared_spin_lock(const shared_spin_lock&);
+		shared_spin_lock& operator=(const shared_spin_lock&);
+
+	public:
+		shared_spin_lock(){state.store(0,std::memory_order_relaxed);}
+
+		void lock()
+		{
+			unsigned s = state.load(std::memory_order_relaxed);
+			while ((s&writer)!=0 || !state.compare_exchange_weak(s,s|writer,std::memory_order_acquire))
+			{
+				if ((s&writer)!=0)
+				{
+					std::this_thread::yield();
+					s = state.load(std::memory_order_relaxed);
+				}
+			}
+			while (state.load(std::memory_order_acquire)!=writer)
+			{
+				std::this_thread::yield();
+			}
+		}
+		void unlock(){state.fetch_sub(writer,std::memory_order_release);}
+
+		void lock_shared()
+		{
+			unsigned s = state.load(std::memory_order_relaxed);
+			while ((s&writer)!=0 || !state.compare_exchange_weak(s,s+1,std::memory_order_acquire))
+			{
+				if ((s&writer)!=0)
+				{
+					std::this_thread::yield();
+					s = state.load(std::memory_order_relaxed);
+				}
+			}
+		}
+		void unlock_shared(){state.fetch_sub(1,std::memory_order_release);}
+	};
+
+	/************************************************************************/
+	/*	concurrent_hash_map:分片加锁的并发哈希表
+		1.由2的幂个分片组成,每个分片是一个hashtable加一把读写锁,按hash_mix后哈希值的高位选分片,
+		  与分片内按低位/取模选桶互不相关
+		2.find/visit/size只加读锁,insert/erase/upsert加写锁;不同分片的操作互不阻塞
+		3.不提供迭代器:find把值拷出,visit在持锁期间对元素调用函数对象,函数对象中不能再访问本容器
+		4.分片开启渐进式重建,扩容时写锁内只分配新桶数组,不一次性搬动全部结点;查找不迁移,读锁下只读
+		5.结点与桶数组用malloc_alloc分配,不经过不加锁的内存池
+	*/
+	/************************************************************************/
+	template<class Key,class T,class HashFcn=hash<Key>,class EqualKey=equal_to<Key>>
+	class concurrent_hash_map
+	{
+	public:
+		typedef Key					key_type;
+		typedef T					mapped_type;
+		typedef pair<const Key,T>	value_type;
+		typedef HashFcn				hasher;
+		typedef EqualKey			key_equal;
+		typedef size_t				size_type;
+
+	private:
+		typedef hashtable<value_type,Key,HashFcn,selectFirst<value_type>,EqualKey,prime_bucket_policy,false,malloc_alloc> table_type;
+
+		//每个分片独占缓存行,避免相邻分片的锁互相伪共享
+		struct shard
+		{
+			shared_spin_lock lock;
+			table_type table;
+			char pad[cache_line_size];
+
+			shard():table(100,hasher(),key_equal()){table.set_incremental_rehash(true);}
+		};
+
+		//加锁/解锁的作用域守卫
+		struct shared_guard
+		{
+			shared_spin_lock& lock;
+			explicit shared_guard(shared_spin_lock& l):lock(l){lock.lock_shared();}
+			~shared_guard(){lock.unlock_shared();}
+		};
+		struct unique_guard
+		{
+			shared_spin_lock& lock;
+			explicit unique_guard(shared_spin_lock& l):lock(l){lock.lock();}
+			~unique_guard(){lock.unlock();}
+		};
+
+		hasher hash;
+		shard* shards;
+		size_type shard_mask;
+		unsigned shard_shift;
+
+		concurrent_hash_map(const concurrent_hash_map&);
+		concurrent_hash_map& operator=(const concurrent_hash_map&);
+
+		shard& shard_of(const key_type& k)const
+		{
+			const size_t h = hash_mix(hash(k));
+			return shards[(h>>shard_shift)&shard_mask];
+		}
+
+	public:
+		//分片数向上取整为2的幂,默认64片
+		explicit concurrent_hash_map(size_type shard_count=64)
+		{
+			const size_type n = round_up_pow2(max(shard_count,size_type(2)));
+			unsigned bits = 0;
+			while ((size_type(1)<<bits)<n)
+			{
+				++bits;
+			}
+			shards = new shard[n];
+			shard_mask = n-1;
+			shard_shift = unsigned(sizeof(size_t)*CHAR_BIT)-bits;
+		}
+		~concurrent_hash_map(){delete[] shards;}
+
+		size_type shard_count()const{return shard_mask+1;}
+
+		//并发修改时只是近似值
+		size_type size()const
+		{
+			size_type n = 0;
+			for (size_type i = 0; i <= shard_mask; ++i)
+			{
+				shared_guard guard(shards[i].lock);
+				n += shards[i].table.size();
+			}
+			return n;
+		}
+		bool empty()const{return size()==0;}
+
+		//找到时把值拷到result
+		bool find(const key_type& k,T& result)const
+		{
+			shard& s = shard_of(k);
+			shared_guard guard(s.lock);
+			typename table_type::const_iterator it = s.table.find(k);
+			if (it==s.table.end())
+			{
+				return false;
+			}
+			result = it->second;
+			return true;
+		}
+
+		bool contains(const key_type& k)const
+		{
+			shard& s = shard_of(k);
+			shared_guard guard(s.lock);
+			return s.table.find(k)!=s.table.end();
+		}
+
+		//持读锁对k的值调用f(const T&),返回是否找到
+		template<class Func>
+		bool visit(const key_type& k,Func f)const
+		{
+			shard& s = shard_of(k);
+			shared_guard guard(s.lock);
+			typename table_type::const_iterator it = s.table.find(k);
+			if (it==s.table.end())
+			{
+				return false;
+			}
+			f(it->second);
+			return true;
+		}
+
+		//逐个分片持读锁对全部元素调用f(const value_type&),不是整表的快照
+		template<class Func>
+		void visit_all(Func f)const
+		{
+			for (size_type i = 0; i <= shard_mask; ++i)
+			{
+				shared_guard guard(shards[i].lock);
+				for (typename table_type::const_iterator it = shards[i].table.begin(); it != shards[i].table.end(); ++it)
+				{
+					f(*it);
+				}
+			}
+		}
+
+		//键已存在时不插入,返回false
+		bool insert(const key_type& k,const T& v)
+		{
+			shard& s = shard_of(k);
+			unique_guard guard(s.lock);
+			return s.table.insert_unique(value_type(k,v)).second;
+		}
+
+		//不存在则插入,存在则覆盖,返回是否新插入
+		bool upsert(const key_type& k,const T& v)
+		{
+			shard& s = shard_of(k);
+			unique_guard guard(s.lock);
+			pair<typename table_type::iterator,bool> p = s.table.insert_unique(value_type(k,v));
+			if (!p.second)
+			{
+				p.first->second = v;
+			}
+			return p.second;
+		}
+
+		//不存在则插入v,存在则持写锁调用f(T&)原地修改,返回是否新插入
+		template<class Func>
+		bool upsert(const key_type& k,const T& v,Func f)
+		{
+			shard& s = shard_of(k);
+			unique_guard guard(s.lock);
+			pair<typename table_type::iterator,bool> p = s.table.insert_unique(value_type(k,v));
+			if (!p.second)
+			{
+				f(p.first->second);
+			}
+			return p.second;
+		}
+
+		bool erase(const key_type& k)
+		{
+			shard& s = shard_of(k);
+			unique_guard guard(s.lock);
+			return s.table.erase(k)!=0;
+		}
+
+		void clear()
+		{
+			for (size_type i = 0; i <= shard_mask; ++i)
+			{
+				unique_guard guard(shards[i].lock);
+				shards[i].table.clear();
+			}
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef _MINI_STL_CONCURRENT_STACK_H_
+#define _MINI_STL_CONCURRENT_STACK_H_
+
+#include <atomic>
+#include <new>
+#include "Construct.h"
+#include "Segmented_vector.h"
+
+namespace MINI_STL
+{
+	/************************************************************************/
+	/*	concurrent_stack:无锁栈(Treiber)
+		1.结点按下标存放在分块数组中,块只增不减,已弹出的结点进入空闲链表复用
+		2.栈顶与空闲链表头都是64位的(版本号<<32|下标+1),每次CAS版本号加1,避免ABA
+		3.CAS失败时到消除数组中尝试与相反操作直接配对,减轻栈顶竞争
+		4.alloc内存池不是线程安全的,块直接向堆申请
+	*/
+	/************************************************************************/
+	template<class T>
+	class concurrent_stack
+	{
+	public:
+		typedef T			value_type;
+		typedef T&			reference;
+		typedef const T&	const_reference;
+		typedef size_t		size_type;
+
+	private:
+		typedef unsigned long long tagged_type;
+		enum { elimination_slots = 16, elimination_spins = 64 };
+		enum { npos = ~0u };
+
+		struct node
+		{
+			T data;
+			std::atomic<unsigned> next;    //下一个结点的下标+1,0表示空
+		};
+
+		std::atomic<node*> blocks[segment_max_blocks];
+		std::atomic<unsigned> node_nums;   //已分配出去的结点个数
+		std::atomic<tagged_type> top;
+		std::atomic<tagged_type> free_top;
+		std::atomic<unsigned> elimination[elimination_slots];    //等待配对的push结点
+		std::atomic<unsigned> elimination_seed;
+
+		concurrent_stack(const concurrent_stack&);
+		concurrent_stack& operator=(const concurrent_stack&);
+
+		static unsigned index_of(tagged_type x){return unsigned(x);}
+		static tagged_type make_tagged(tagged_type old,unsigned index)
+		{
+			return (((old>>32)+1)<<32)|index;
+		}
+
+		//下标为i-1的结点,所在块不存在则分配并用CAS安装
+		node* node_at(unsigned i)
+		{
+			const size_type n = i-1;
+			const size_type k = segment_block_of(n);
+			node* p = blocks[k].load(std::memory_order_acquire);
+			if (p==0)
+			{
+				node* fresh = static_cast<node*>(::operator new(sizeof(node)*segment_block_size(k)));
+				for (size_type j = 0; j != segment_block_size(k); ++j)
+				{
+					new(&fresh[j].next) std::atomic<unsigned>(0);
+				}
+				if (blocks[k].compare_exchange_strong(p,fresh,std::memory_order_acq_rel))
+				{
+					p = fresh;
+				}
+				else
+				{
+					::operator delete(fresh);
+				}
+			}
+			return p+(n-segment_block_start(k));
+		}
+
+		void push_node(std::atomic<tagged_type>& head,unsigned i)
+		{
+			node* p = node_at(i);
+			tagged_type old = head.load(std::memory_order_relaxed);
+			do
+			{
+				p->next.store(index_of(old),std::memory_order_relaxed);
+			} while (!head.compare_exchange_weak(old,make_tagged(old,i),std::memory_order_release,std::memory_order_relaxed));
+		}
+
+		//只尝试一次,失败返回false
+		bool try_push_node(std::atomic<tagged_type>& head,unsigned i)
+		{
+			tagged_type old = head.load(std::memory_order_relaxed);
+			node_at(i)->next.store(index_of(old),std::memory_order_relaxed);
+			return head.compare_exchange_strong(old,make_tagged(old,i),std::memory_order_release,std::memory_order_relaxed);
+		}
+
+		//返回弹出的结点,栈空返回0,CAS失败返回npos
+		unsigned try_pop_node(std::atomic<tagged_type>& head)
+		{
+			tagged_type old = head.load(std::memory_order_acquire);
+			const unsigned i = index_of(old);
+			if (i==0)
+			{
+				return 0;
+			}
+			const unsigned next = node_at(i)->next.load(std::memory_order_relaxed);
+			if (head.compare_exchange_strong(old,make_tagged(old,next),std::memory_order_acquire,std::memory_order_relaxed))
+			{
+				return i;
+			}
+			return npos;
+		}
+
+		unsigned pop_node(std::atomic<tagged_type>& head)
+		{
+			unsigned i;
+			while ((i = try_pop_node(head))==npos)
+				;
+			return i;
+		}
+
+		//优先复用空闲结点
+		unsigned acquire_node()
+		{
+			unsigned i = pop_node(free_top);
+			return i!=0 ? i : node_nums.fetch_add(1,std::memory_order_relaxed)+1;
+		}
+
+		unsigned elimination_slot()
+		{
+			return (elimination_seed.fetch_add(1,std::memory_order_relaxed)*2654435761u>>16)%elimination_slots;
+		}
+
+		//把结点挂到消除数组中等待pop取走,成功配对返回true
+		bool try_eliminate_push(unsigned i)
+		{
+			std::atomic<unsigned>& slot = elimination[elimination_slot()];
+			unsigned expected = 0;
+			if (!slot.compare_exchange_strong(expected,i,std::memory_order_release,std::memory_order_relaxed))
+			{
+				return false;
+			}
+			for (int spin = 0; spin != elimination_spins; ++spin)
+			{
+				if (slot.load(std::memory_order_acquire)!=i)
+				{
+					return true;
+				}
+			}
+			expected = i;
+			return !slot.compare_exchange_strong(expected,0,std::memory_order_relaxed);
+		}
+
+		//从消除数组中取走一个等待中的push结点
+		unsigned try_eliminate_pop()
+		{
+			std::atomic<unsigned>& slot = elimination[elimination_slot()];
+			unsigned i = slot.load(std::memory_order_acquire);
+			if (i!=0 && slot.compare_exchange_strong(i,0,std::memory_order_acquire,std::memory_order_relaxed))
+			{
+				return i;
+			}
+			return 0;
+		}
+
+		void take(unsigned i,T& x)
+		{
+			node* p = node_at(i);
+			x = p->data;
+			destroy(&p->data);
+			push_node(free_top,i);
+		}
+
+	public:
+		concurrent_stack()
+		{
+			for (size_type i = 0; i != segment_max_blocks; ++i)
+			{
+				blocks[i].store(0,std::memory_order_relaxed);
+			}
+			for (size_type i = 0; i != elimination_slots; ++i)
+			{
+				elimination[i].store(0,std::memory_order_relaxed);
+			}
+			node_nums.store(0,std::memory_order_relaxed);
+			top.store(0,std::memory_order_relaxed);
+			free_top.store(0,std::memory_order_relaxed);
+			elimination_seed.store(0,std::memory_order_relaxed);
+		}
+		~concurrent_stack()
+		{
+			for (unsigned i = index_of(top.load(std::memory_order_relaxed)); i != 0; )
+			{
+				node* p = node_at(i);
+				destroy(&p->data);
+				i = p->next.load(std::memory_order_relaxed);
+			}
+			for (size_type i = 0; i != segment_max_blocks; ++i)
+			{
+				::operator delete(blocks[i].load(std::memory_order_relaxed));
+			}
+		}
+
+		//并发时只是近似值
+		bool empty()const{return index_of(top.load(std::memory_order_acquire))==0;}
+
+		void push(const T& x)
+		{
+			const unsigned i = acquire_node();
+			construct(&node_at(i)->data,x);
+			while (!try_push_node(top,i))
+			{
+				if (try_eliminate_push(i))
+				{
+					return;
+				}
+			}
+		}
+
+		//栈空返回false
+		bool try_pop(T& x)
+		{
+			for (;;)
+			{
+				const unsigned i = try_pop_node(top);
+				if (i==0)
+				{
+					return false;
+				}
+				if (i!=npos)
+				{
+					take(i,x);
+					return true;
+				}
+				const unsigned e = try_eliminate_pop();
+				if (e!=0)
+				{
+					take(e,x);
+					return true;
+				}
+			}
+		}
+	};
+}
+
+#endif
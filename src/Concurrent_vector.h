@@ -0,0 +1,240 @@
+#ifndef _MINI_STL_CONCURRENT_VECTOR_H_
+#define _MINI_STL_CONCURRENT_VECTOR_H_
+
+#include <atomic>
+#include <new>
+#include <thread>
+#include "Construct.h"
+#include "Iterator.h"
+#include "Uninitialized.h"
+#include "Segmented_vector.h"
+
+namespace MINI_STL
+{
+	/************************************************************************/
+	/*	concurrent_vector:可多线程并发追加的vector
+		1.与segmented_vector相同的分块布局,元素地址永不改变
+		2.push_back/grow_by用fetch_add预留下标,缺失的块用CAS安装
+		3.ele_nums是已预留的个数,ready_nums是已构造完的前缀长度;写者构造完后等前面的预留都发布了
+		  再推进ready_nums,size()/end()只返回ready_nums,可与追加并发遍历[begin(),end())
+		4.元素的拷贝构造不能抛出异常,否则之后的写者会一直等待
+		5.alloc内存池不是线程安全的,块直接向堆申请
+	*/
+	/************************************************************************/
+	template<class Container,class Value>
+	struct concurrent_vector_iterator
+	{
+		typedef random_access_iterator_tag	iterator_category;
+		typedef Value						value_type;
+		typedef Value*						pointer;
+		typedef Value&						reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+
+		Container* cv;
+		size_type index;
+
+		concurrent_vector_iterator():cv(0),index(0){}
+		concurrent_vector_iterator(Container* c,size_type i):cv(c),index(i){}
+		template<class C,class V>
+		concurrent_vector_iterator(const concurrent_vector_iterator<C,V>& x):cv(x.cv),index(x.index){}
+
+		reference operator*()const{return (*cv)[index];}
+		pointer operator->()const{return &(operator*());}
+
+		concurrent_vector_iterator& operator++(){++index;return *this;}
+		concurrent_vector_iterator operator++(int){auto temp = *this;++index;return temp;}
+		concurrent_vector_iterator& operator--(){--index;return *this;}
+		concurrent_vector_iterator operator--(int){auto temp = *this;--index;return temp;}
+		concurrent_vector_iterator& operator+=(difference_type n){index += n;return *this;}
+		concurrent_vector_iterator& operator-=(difference_type n){index -= n;return *this;}
+		concurrent_vector_iterator operator+(difference_type n)const{return concurrent_vector_iterator(cv,index+n);}
+		concurrent_vector_iterator operator-(difference_type n)const{return concurrent_vector_iterator(cv,index-n);}
+		difference_type operator-(const concurrent_vector_iterator& x)const{return difference_type(index)-difference_type(x.index);}
+		reference operator[](difference_type n)const{return (*cv)[index+n];}
+
+		bool operator==(const concurrent_vector_iterator& x)const{return index==x.index;}
+		bool operator!=(const concurrent_vector_iterator& x)const{return index!=x.index;}
+		bool operator<(const concurrent_vector_iterator& x)const{return index<x.index;}
+		bool operator>(const concurrent_vector_iterator& x)const{return index>x.index;}
+		bool operator<=(const concurrent_vector_iterator& x)const{return index<=x.index;}
+		bool operator>=(const concurrent_vector_iterator& x)const{return index>=x.index;}
+	};
+
+	template<class T>
+	class concurrent_vector
+	{
+	public:
+		typedef T							value_type;
+		typedef T*							pointer;
+		typedef const T*					const_pointer;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+
+		typedef concurrent_vector_iterator<concurrent_vector,T>				iterator;
+		typedef concurrent_vector_iterator<const concurrent_vector,const T>	const_iterator;
+
+	protected:
+		std::atomic<T*> blocks[segment_max_blocks];
+		std::atomic<size_type> ele_nums;
+		std::atomic<size_type> ready_nums;
+
+		static T* allocate_block(size_type k)
+		{
+			return static_cast<T*>(::operator new(sizeof(T)*segment_block_size(k)));
+		}
+		static void deallocate_block(T* p)
+		{
+			::operator delete(p);
+		}
+
+		//返回第k块,不存在则分配并用CAS安装,失败者释放自己的块
+		T* block_at(size_type k)
+		{
+			T* p = blocks[k].load(std::memory_order_acquire);
+			if (p==0)
+			{
+				T* fresh = allocate_block(k);
+				if (blocks[k].compare_exchange_strong(p,fresh,std::memory_order_acq_rel))
+				{
+					p = fresh;
+				}
+				else
+				{
+					deallocate_block(fresh);
+				}
+			}
+			return p;
+		}
+
+		//[first,first+n)构造完成后按预留顺序发布
+		void publish(size_type first,size_type n)
+		{
+			while (ready_nums.load(std::memory_order_acquire)!=first)
+			{
+				std::this_thread::yield();
+			}
+			ready_nums.store(first+n,std::memory_order_release);
+		}
+
+		//在已预留的[first,first+n)上逐块填充
+		void fill_reserved(size_type first,size_type n,const T& x)
+		{
+			while (n>0)
+			{
+				const size_type block = segment_block_of(first);
+				const size_type offset = first-segment_block_start(block);
+				const size_type len = min(n,segment_block_size(block)-offset);
+				Uninitialized_fill_n(block_at(block)+offset,len,x);
+				first += len;
+				n -= len;
+			}
+		}
+
+		void initialize()
+		{
+			for (size_type i = 0; i != segment_max_blocks; ++i)
+			{
+				blocks[i].store(0,std::memory_order_relaxed);
+			}
+			ele_nums.store(0,std::memory_order_relaxed);
+			ready_nums.store(0,std::memory_order_relaxed);
+		}
+
+	public:
+		concurrent_vector(){initialize();}
+		concurrent_vector(const concurrent_vector& x)
+		{
+			initialize();
+			for (const_iterator it = x.begin(); it != x.end(); ++it)
+			{
+				push_back(*it);
+			}
+		}
+		~concurrent_vector()
+		{
+			clear();
+			for (size_type i = 0; i != segment_max_blocks; ++i)
+			{
+				deallocate_block(blocks[i].load(std::memory_order_relaxed));
+			}
+		}
+
+		//读操作,只能看到已发布的元素
+		size_type size()const{return ready_nums.load(std::memory_order_acquire);}
+		bool empty()const{return size()==0;}
+
+		reference operator[](size_type n)
+		{
+			const size_type block = segment_block_of(n);
+			return blocks[block].load(std::memory_order_acquire)[n-segment_block_start(block)];
+		}
+		const_reference operator[](size_type n)const
+		{
+			const size_type block = segment_block_of(n);
+			return blocks[block].load(std::memory_order_acquire)[n-segment_block_start(block)];
+		}
+		reference front(){return (*this)[0];}
+		const_reference front()const{return (*this)[0];}
+		reference back(){return (*this)[size()-1];}
+		const_reference back()const{return (*this)[size()-1];}
+
+		iterator begin(){return iterator(this,0);}
+		iterator end(){return iterator(this,size());}
+		const_iterator begin()const{return const_iterator(this,0);}
+		const_iterator end()const{return const_iterator(this,size());}
+		const_iterator cbegin()const{return begin();}
+		const_iterator cend()const{return end();}
+
+		//并发写操作
+		iterator push_back(const T& x)
+		{
+			const size_type n = ele_nums.fetch_add(1,std::memory_order_acq_rel);
+			const size_type block = segment_block_of(n);
+			construct(block_at(block)+(n-segment_block_start(block)),x);
+			publish(n,1);
+			return iterator(this,n);
+		}
+
+		//预留n个连续位置并用x填充,返回第一个新元素
+		iterator grow_by(size_type n,const T& x)
+		{
+			const size_type first = ele_nums.fetch_add(n,std::memory_order_acq_rel);
+			fill_reserved(first,n,x);
+			publish(first,n);
+			return iterator(this,first);
+		}
+		iterator grow_by(size_type n){return grow_by(n,T());}
+
+		//预先分配能容纳n个元素的块
+		void reserve(size_type n)
+		{
+			if (n>0)
+			{
+				const size_type last = segment_block_of(n-1);
+				for (size_type k = 0; k <= last; ++k)
+				{
+					block_at(k);
+				}
+			}
+		}
+
+		//以下操作不能与其他操作并发
+		void clear()
+		{
+			const size_type n = ele_nums.load(std::memory_order_relaxed);
+			for (size_type block = 0; segment_block_start(block)<n; ++block)
+			{
+				T* p = blocks[block].load(std::memory_order_relaxed);
+				const size_type len = min(segment_block_size(block),n-segment_block_start(block));
+				destroy(p,p+len);
+			}
+			ele_nums.store(0,std::memory_order_relaxed);
+			ready_nums.store(0,std::memory_order_release);
+		}
+	};
+}
+
+#endif
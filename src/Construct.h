@@ -3,6 +3,7 @@
 
 #include <new>
 #include "TypeTraits.h"
+#include "Iterator.h"
 
 namespace MINI_STL
 {
@@ -13,6 +14,13 @@ namespace MINI_STL
 		new(p) T1(value);
 	}
 
+	//默认构造,使用placement new构造
+	template <class T>
+	inline void construct(T *p)
+	{
+		new(p) T();
+	}
+
 	//析构函数,调用类型的析构函数
 	template <class T>
 	inline void destroy(T *pointer)
@@ -35,6 +43,13 @@ namespace MINI_STL
 
 	template <class ForwardIterator>
 	inline void _destroy_aux(ForwardIterator first,ForwardIterator last,_false_type)
+	{
+		typedef typename segmented_iterator_traits<ForwardIterator>::is_segmented_iterator is_segmented;
+		_destroy_segmented(first,last,is_segmented());
+	}
+
+	template <class ForwardIterator>
+	inline void _destroy_segmented(ForwardIterator first,ForwardIterator last,_false_type)
 	{
 		while(first<last)
 		{
@@ -42,6 +57,26 @@ namespace MINI_STL
 		}
 	}
 
+	//分段迭代器逐块析构,块内为原生指针
+	template <class SegmentedIterator>
+	void _destroy_segmented(SegmentedIterator first,SegmentedIterator last,_true_type)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		typename traits::segment_iterator sfirst = traits::segment(first);
+		typename traits::segment_iterator slast = traits::segment(last);
+		if (sfirst==slast)
+		{
+			MINI_STL::destroy(traits::local(first),traits::local(last));
+			return;
+		}
+		MINI_STL::destroy(traits::local(first),traits::end(sfirst));
+		for (++sfirst; sfirst!=slast; ++sfirst)
+		{
+			MINI_STL::destroy(traits::begin(sfirst),traits::end(sfirst));
+		}
+		MINI_STL::destroy(traits::begin(slast),traits::local(last));
+	}
+
 	template <class ForwardIterator>
 	inline void _destroy_aux(ForwardIterator first,ForwardIterator last,_true_type)
 	{
@@ -10,17 +10,18 @@
 
 namespace MINI_STL
 {
-	inline size_t deque_buf_size(size_t size)
+	//每个缓冲区的元素个数,buf_bytes为缓冲区字节数
+	inline size_t deque_buf_size(size_t size,size_t buf_bytes=512)
 	{
-		return size<512?size_t(512/size):size_t(1);
+		return size<buf_bytes?size_t(buf_bytes/size):size_t(1);
 	}
 
-	template<class T,class Ref,class Ptr>
+	template<class T,class Ref,class Ptr,size_t BufBytes=512>
 	struct deque_iterator
 	{
-		typedef deque_iterator<T,T&,T*>     			iterator;
-		typedef deque_iterator<T,const T&,const T*>  	const_iterator;
-		static size_t buffer_size(){return deque_buf_size(sizeof(T));}
+		typedef deque_iterator<T,T&,T*,BufBytes>     			iterator;
+		typedef deque_iterator<T,const T&,const T*,BufBytes>  	const_iterator;
+		static size_t buffer_size(){return deque_buf_size(sizeof(T),BufBytes);}
 
 		typedef random_access_iterator_tag iterator_category;
 		typedef T 	value_type;
@@ -35,7 +36,7 @@ namespace MINI_STL
 		T*  M_last;
 		map_pointer M_node;
 
-		deque_iterator(T* x,map_pointer y):M_cur(x),M_first(*y),M_last(*y+deque_buf_size()),M_node(y){}
+		deque_iterator(T* x,map_pointer y):M_cur(x),M_first(*y),M_last(*y+buffer_size()),M_node(y){}
 		deque_iterator():M_cur(0),M_first(0),M_last(0),M_node(0){}
 		deque_iterator(const iterator& x):M_cur(x.M_cur),M_first(x.M_first),M_last(x.M_last),M_node(x.M_node){}
 
@@ -133,15 +134,49 @@ namespace MINI_STL
 		bool operator>=(const deque_iterator& x)const {return !(*this<x);}
 	};
 
-	template<class T,class Ref,class Ptr>
-	inline deque_iterator<T,Ref,Ptr>
-	operator+(ptrdiff_t n,const deque_iterator<T,Ref,Ptr>& x)
+	template<class T,class Ref,class Ptr,size_t BufBytes>
+	inline deque_iterator<T,Ref,Ptr,BufBytes>
+	operator+(ptrdiff_t n,const deque_iterator<T,Ref,Ptr,BufBytes>& x)
 	{
 		return x+n;
 	}
 
+	//deque_iterator是分段迭代器,每个缓冲区为一段
+	template<class T,class Ref,class Ptr,size_t BufBytes>
+	struct segmented_iterator_traits<deque_iterator<T,Ref,Ptr,BufBytes>>
+	{
+		typedef _true_type is_segmented_iterator;
+		typedef deque_iterator<T,Ref,Ptr,BufBytes> iterator;
+		typedef typename iterator::map_pointer segment_iterator;
+		typedef T* local_iterator;
+
+		static segment_iterator segment(const iterator& it){return it.M_node;}
+		static local_iterator local(const iterator& it){return it.M_cur;}
+		static local_iterator begin(segment_iterator s){return *s;}
+		static local_iterator end(segment_iterator s){return *s+iterator::buffer_size();}
 
-	template <class T>
+		//指向块尾时规范化到下一块的开头,与operator++一致
+		static iterator compose(segment_iterator s,local_iterator p)
+		{
+			iterator it;
+			if (p==end(s))
+			{
+				++s;
+				p = *s;
+			}
+			it.set_node(s);
+			it.M_cur = p;
+			return it;
+		}
+	};
+
+	/************************************************************************/
+	/*	deque
+		1.BufBytes为每个缓冲区的字节数(如4096、65536)
+		2.释放的缓冲区先放入少量备用缓冲区中,稳态的push/pop不再申请内存
+	*/
+	/************************************************************************/
+	template <class T,size_t BufBytes=512>
 	class deque
 	{
 	public:
@@ -153,23 +188,44 @@ namespace MINI_STL
 		typedef size_t 	size_type;
 		typedef ptrdiff_t 	difference_type;
 
-		typedef deque_iterator<T,T&,T*>		iterator;
-		typedef deque_iterator<T,const T&,const T*>	const_iterator;
+		typedef deque_iterator<T,T&,T*,BufBytes>		iterator;
+		typedef deque_iterator<T,const T&,const T*,BufBytes>	const_iterator;
 
 
 	protected:
 		typedef pointer*	map_pointer;
 		typedef Allocator<T> dataAllocator;
 		typedef Allocator<T*> mapAllocator;
-		static size_t buffer_size() { return deque_buf_size(sizeof(T)); }
+		static size_t buffer_size() { return deque_buf_size(sizeof(T),BufBytes); }
+		enum { max_spare_nodes = 4 };
 	protected:
+		//优先从备用缓冲区中获取
 		T* allocate_nodes()
 		{
-			return dataAllocator::allocate(deque_buf_size(sizeof(T)));
+			if (spare_nums>0)
+			{
+				return spare_nodes[--spare_nums];
+			}
+			return dataAllocator::allocate(buffer_size());
 		}
+		//备用缓冲区未满时留作下次使用
 		void deallocate_nodes(T* p)
 		{
-			dataAllocator::deallocate(p,deque_buf_size(sizeof(T)));
+			if (spare_nums<max_spare_nodes)
+			{
+				spare_nodes[spare_nums++] = p;
+			}
+			else
+			{
+				dataAllocator::deallocate(p,buffer_size());
+			}
+		}
+		void release_spare_nodes()
+		{
+			while (spare_nums>0)
+			{
+				dataAllocator::deallocate(spare_nodes[--spare_nums],buffer_size());
+			}
 		}
 		T** allocate_map(size_t n) {return mapAllocator::allocate(n);}
 		void deallocate_map(T** p,size_t n) {mapAllocator::deallocate(p,n);}
@@ -189,10 +245,10 @@ namespace MINI_STL
 		template<class ForwardIterator>
 		void range_initialize(ForwardIterator first,ForwardIterator last,forward_iterator_tag);
 		//Constructor
-		deque():start(),finish(),map(0),map_size(0){ create_map_and_nodes(0); }
-		explicit deque(size_type n):start(),finish(),map(0),map_size(0){create_map_and_nodes(n); fill_initialize(T());}
-		deque(size_type n,const T& value):start(),finish(),map(0),map_size(0){create_map_and_nodes(n); fill_initialize(value);}
-		deque(const deque& x)
+		deque():start(),finish(),map(0),map_size(0),spare_nums(0){ create_map_and_nodes(0); }
+		explicit deque(size_type n):start(),finish(),map(0),map_size(0),spare_nums(0){create_map_and_nodes(n); fill_initialize(T());}
+		deque(size_type n,const T& value):start(),finish(),map(0),map_size(0),spare_nums(0){create_map_and_nodes(n); fill_initialize(value);}
+		deque(const deque& x):spare_nums(0)
 		{	
 			create_map_and_nodes(x.size());  
 			Uninitialized_copy(x.begin(),x.end(),start);
@@ -202,6 +258,7 @@ namespace MINI_STL
 		~deque(){
 			clear(); 
 			dataAllocator::deallocate(start.M_first,buffer_size()); 
+			release_spare_nodes();
 			mapAllocator::deallocate(map,map_size);}
 
 		iterator begin(){return start;}
@@ -226,6 +283,25 @@ namespace MINI_STL
 		void pop_back_aux();
 		void pop_front_aux();
 		iterator insert_aux(iterator position,const value_type& x);
+		template<class ForwardIterator>
+		void insert_aux(iterator position,ForwardIterator first,ForwardIterator last,size_type n);
+		//预留n个元素的空间,一次性扩充map并分配缓冲区,返回新的finish/start
+		iterator reserve_elements_at_back(size_type n);
+		iterator reserve_elements_at_front(size_type n);
+		void new_elements_at_back(size_type new_elements);
+		void new_elements_at_front(size_type new_elements);
+		template<class InputIterator>
+		void range_append(InputIterator first,InputIterator last,input_iterator_tag);
+		template<class ForwardIterator>
+		void range_append(ForwardIterator first,ForwardIterator last,forward_iterator_tag);
+		template<class InputIterator>
+		void range_prepend(InputIterator first,InputIterator last,input_iterator_tag);
+		template<class ForwardIterator>
+		void range_prepend(ForwardIterator first,ForwardIterator last,forward_iterator_tag);
+		template<class InputIterator>
+		iterator range_insert(iterator position,InputIterator first,InputIterator last,input_iterator_tag);
+		template<class ForwardIterator>
+		iterator range_insert(iterator position,ForwardIterator first,ForwardIterator last,forward_iterator_tag);
 	public:
 		void push_back(const value_type& v);
 		void push_front(const value_type& v);
@@ -235,6 +311,16 @@ namespace MINI_STL
 		iterator erase(iterator position);
 		iterator erase(iterator first,iterator last);
 		iterator insert(iterator position,const value_type& x);
+		template<class InputIterator>
+		iterator insert(iterator position,InputIterator first,InputIterator last);
+
+		//批量操作:map与缓冲区只预留一次,元素逐块复制/析构
+		template<class InputIterator>
+		void append(InputIterator first,InputIterator last);
+		template<class InputIterator>
+		void prepend(InputIterator first,InputIterator last);
+		void pop_front_n(size_type n);
+		void pop_back_n(size_type n);
 
 		void swap(deque& x);
 		deque& operator=(const deque& x);
@@ -246,22 +332,24 @@ namespace MINI_STL
 	private:
 		map_pointer map;
 		size_type map_size;
+		T* spare_nodes[max_spare_nodes];
+		size_type spare_nums;
 
 
 	};
 
-	template<class T>
+	template<class T,size_t BufBytes>
 	template<class InputIterator>
-	void deque<T>::range_initialize(InputIterator first,InputIterator last,input_iterator_tag)
+	void deque<T,BufBytes>::range_initialize(InputIterator first,InputIterator last,input_iterator_tag)
 	{
 		create_map_and_nodes(0);
 		for(;first!=last;++first)
 			push_back(*first);
 	}
 
-	template<class T>
+	template<class T,size_t BufBytes>
 	template<class ForwardIterator>
-	void deque<T>::range_initialize(ForwardIterator first,ForwardIterator last,forward_iterator_tag)
+	void deque<T,BufBytes>::range_initialize(ForwardIterator first,ForwardIterator last,forward_iterator_tag)
 	{
 		size_type n = distance(first,last);
 		create_map_and_nodes(n);
@@ -276,23 +364,23 @@ namespace MINI_STL
 		Uninitialized_copy(first,last,finish.M_first);
 	}
 
-	template<class T>
+	template<class T,size_t BufBytes>
 	template<class Integer>
-	void deque<T>::deque_aux(Integer n,Integer val,_true_type)
+	void deque<T,BufBytes>::deque_aux(Integer n,Integer val,_true_type)
 	{
 		create_map_and_nodes(n);
 		fill_initialize(val);
 	}
 
-	template<class T>
+	template<class T,size_t BufBytes>
 	template<class InputIterator>
-	void deque<T>::deque_aux(InputIterator first,InputIterator last,_false_type)
+	void deque<T,BufBytes>::deque_aux(InputIterator first,InputIterator last,_false_type)
 	{
 		range_initialize(first,last,iterator_category(first));
 	}
 
-	template<class T>
-	void deque<T>::fill_initialize(const value_type& value)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::fill_initialize(const value_type& value)
 	{
 		map_pointer cur;
 		for(cur=start.M_node;cur<finish.M_node;++cur)
@@ -302,8 +390,8 @@ namespace MINI_STL
 		Uninitialized_fill(finish.M_first,finish.M_cur,value);
 	}
 
-	template<class T>
-	void deque<T>::create_map_and_nodes(size_type num_elements)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::create_map_and_nodes(size_type num_elements)
 	{
 		size_type num_nodes = num_elements/buffer_size()+1;
 		map_size = max((size_type)initial_map_size,num_nodes+2);
@@ -324,16 +412,16 @@ namespace MINI_STL
 		finish.M_cur = finish.M_first + num_elements%buffer_size();
 	}
 
-	template<class T>
+	template<class T,size_t BufBytes>
 	template<class InputIterator>
-	deque<T>::deque(InputIterator first,InputIterator last)
+	deque<T,BufBytes>::deque(InputIterator first,InputIterator last):spare_nums(0)
 	{
 		typedef typename _is_Integer<InputIterator>::_Integral _Integral;
 		deque_aux(first,last,_Integral());
 	}
 
-	template<class T>
-	void deque<T>::reallocate_map(size_type nodes_to_add,bool add_at_front)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::reallocate_map(size_type nodes_to_add,bool add_at_front)
 	{
 		size_type old_num_nodes = finish.M_node - start.M_node + 1;
 		size_type new_num_nodes = old_num_nodes+nodes_to_add;
@@ -365,8 +453,8 @@ namespace MINI_STL
 		finish.set_node(new_start+old_num_nodes-1);
 	}
 
-	template<class T>
-	void deque<T>::reserve_map_at_back(size_type nodes_to_add)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::reserve_map_at_back(size_type nodes_to_add)
 	{
 		if (nodes_to_add+1>map_size-(finish.M_node-map))
 		{
@@ -374,8 +462,8 @@ namespace MINI_STL
 		}
 	}
 
-	template<class T>
-	void deque<T>::reserve_map_at_front(size_type nodes_to_add)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::reserve_map_at_front(size_type nodes_to_add)
 	{
 		if (nodes_to_add+1>(size_type)(start.M_node-map))
 		{
@@ -383,8 +471,8 @@ namespace MINI_STL
 		}
 	}
 
-	template<class T>
-	void deque<T>::push_back_aux(const value_type& v)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::push_back_aux(const value_type& v)
 	{
 		reserve_map_at_back();
 		*(finish.M_node+1) = allocate_nodes();
@@ -393,8 +481,8 @@ namespace MINI_STL
 		finish.M_cur = finish.M_first;
 	}
 
-	template<class T>
-	void deque<T>::push_front_aux(const value_type& v)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::push_front_aux(const value_type& v)
 	{
 		reserve_map_at_front();
 		*(start.M_node-1) = allocate_nodes();
@@ -403,8 +491,8 @@ namespace MINI_STL
 		construct(start.M_cur,v);
 	}
 
-	template<class T>
-	void deque<T>::push_back(const value_type& v)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::push_back(const value_type& v)
 	{
 		if (finish.M_cur!=finish.M_last-1)
 		{
@@ -417,8 +505,8 @@ namespace MINI_STL
 		}
 	}
 
-	template<class T>
-	void deque<T>::push_front(const value_type& v)
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::push_front(const value_type& v)
 	{
 		if (start.M_cur!=start.M_first)
 		{
@@ -431,8 +519,8 @@ namespace MINI_STL
 		}
 	}
 
-	template<class T>
-	void deque<T>::pop_back_aux()
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::pop_back_aux()
 	{
 		deallocate_nodes(finish.M_first);
 		finish.set_node(finish.M_node-1);
@@ -440,8 +528,8 @@ namespace MINI_STL
 		destroy(finish.M_cur);
 	}
 
-	template<class T>
-	void deque<T>::pop_back()
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::pop_back()
 	{
 		if (finish.M_cur != finish.M_first)
 		{
@@ -454,8 +542,8 @@ namespace MINI_STL
 		}
 	}
 
-	template<class T>
-	void deque<T>::pop_front_aux()
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::pop_front_aux()
 	{
 		destroy(start.M_cur);
 		deallocate_nodes(start.M_first);
@@ -463,8 +551,8 @@ namespace MINI_STL
 		start.M_cur = start.M_first;
 	}
 
-	template<class T>
-	void deque<T>::pop_front()
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::pop_front()
 	{
 		if (start.M_cur!=start.M_last-1)
 		{
@@ -477,19 +565,19 @@ namespace MINI_STL
 		}
 	}
 
-	template<class T>
-	void deque<T>::clear()
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::clear()
 	{
 		for(map_pointer node = start.M_node+1;node<finish.M_node;++node)
 		{
 			destroy(*node,*node+buffer_size());
-			dataAllocator::deallocate(*node,buffer_size());
+			deallocate_nodes(*node);
 		}
 		if (start.M_node!=finish.M_node)
 		{
 			destroy(start.M_cur,start.M_last);
 			destroy(finish.M_first,finish.M_cur);
-			dataAllocator::deallocate(finish.M_first,buffer_size());
+			deallocate_nodes(finish.M_first);
 		}
 		else
 		{
@@ -499,26 +587,26 @@ namespace MINI_STL
 		finish = start;
 	}
 
-	template<class T>
-	typename deque<T>::iterator deque<T>::erase(iterator position)
+	template<class T,size_t BufBytes>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::erase(iterator position)
 	{
 		iterator next = position;
 		++next;
 		difference_type index = position-start;
 		if (index<(size()>>1))
 		{
-			copy_backward(start,position,next);
+			MINI_STL::copy_backward(start,position,next);
 		}
 		else 
 		{
-			copy(next,finish,position);
+			MINI_STL::copy(next,finish,position);
 			pop_back();
 		}
 		return start+index;
 	}
 
-	template<class T>
-	typename deque<T>::iterator deque<T>::erase(iterator first,iterator last)
+	template<class T,size_t BufBytes>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::erase(iterator first,iterator last)
 	{
 		if (first==start&&last==finish)
 		{
@@ -531,32 +619,20 @@ namespace MINI_STL
 			difference_type elems_before = first - start;
 			if (elems_before<difference_type(((size()-n)>>1)) )
 			{
-				copy_backward(start,first,last);
-				iterator new_start = start + n;
-				destroy(start,new_start);
-				for(map_pointer cur = start.M_node;cur<new_start.M_node;++cur)
-				{
-					dataAllocator::deallocate(*cur,buffer_size());
-				}
-				start = new_start;
+				MINI_STL::copy_backward(start,first,last);
+				pop_front_n(n);
 			}
 			else
 			{
-				copy(last,finish,first);
-				iterator new_finish = finish-n;
-				destroy(new_finish,finish);
-				for(map_pointer cur = new_finish.M_node+1;cur<=finish.M_node;++cur)
-				{
-					dataAllocator::deallocate(*cur,buffer_size());
-				}
-				finish = new_finish;
+				MINI_STL::copy(last,finish,first);
+				pop_back_n(n);
 			}
 			return start+elems_before;
 		}
 	}
 
-	template<class T>
-	typename deque<T>::iterator deque<T>::insert_aux(iterator position,const value_type& x)
+	template<class T,size_t BufBytes>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::insert_aux(iterator position,const value_type& x)
 	{
 		difference_type index = position-start;
 		if (index<(size()>>1))
@@ -569,7 +645,7 @@ namespace MINI_STL
 			position = start + index;
 			iterator pos1 = position;
 			++pos1;
-			copy(front2,pos1,front1);
+			MINI_STL::copy(front2,pos1,front1);
 		}
 		else
 		{
@@ -579,14 +655,14 @@ namespace MINI_STL
 			iterator back2 = back1;
 			--back2;
 			position = start + index;
-			copy_backward(position,back2,back1);
+			MINI_STL::copy_backward(position,back2,back1);
 		}
 		*position = x;
-		return pos;
+		return position;
 	}
 
-	template<class T>
-	typename deque<T>::iterator deque<T>::insert(iterator position,const value_type& x)
+	template<class T,size_t BufBytes>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::insert(iterator position,const value_type& x)
 	{
 		if (position.M_cur == start.M_cur)
 		{
@@ -605,29 +681,242 @@ namespace MINI_STL
 		}
 	}
 
-	template<class T>
-	void deque<T>::swap(deque& x)
+	template<class T,size_t BufBytes>
+	template<class InputIterator>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::insert(iterator position,InputIterator first,InputIterator last)
+	{
+		return range_insert(position,first,last,iterator_category(first));
+	}
+
+	template<class T,size_t BufBytes>
+	template<class InputIterator>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::range_insert(iterator position,InputIterator first,InputIterator last,input_iterator_tag)
+	{
+		deque temp(first,last);
+		return insert(position,temp.begin(),temp.end());
+	}
+
+	template<class T,size_t BufBytes>
+	template<class ForwardIterator>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::range_insert(iterator position,ForwardIterator first,ForwardIterator last,forward_iterator_tag)
+	{
+		const difference_type index = position-start;
+		if (position.M_cur==start.M_cur)
+		{
+			range_prepend(first,last,forward_iterator_tag());
+		}
+		else if (position.M_cur==finish.M_cur)
+		{
+			range_append(first,last,forward_iterator_tag());
+		}
+		else
+		{
+			insert_aux(position,first,last,MINI_STL::distance(first,last));
+		}
+		return start+index;
+	}
+
+	//在靠近的一端腾出n个位置,元素较少的一侧整体移动
+	template<class T,size_t BufBytes>
+	template<class ForwardIterator>
+	void deque<T,BufBytes>::insert_aux(iterator position,ForwardIterator first,ForwardIterator last,size_type n)
+	{
+		const difference_type elems_before = position-start;
+		const size_type length = size();
+		if (elems_before<difference_type(length/2))
+		{
+			iterator new_start = reserve_elements_at_front(n);
+			iterator old_start = start;
+			position = start+elems_before;
+			if (elems_before>=difference_type(n))
+			{
+				iterator start_n = start+difference_type(n);
+				Uninitialized_copy(start,start_n,new_start);
+				start = new_start;
+				MINI_STL::copy(start_n,position,old_start);
+				MINI_STL::copy(first,last,position-difference_type(n));
+			}
+			else
+			{
+				ForwardIterator mid = first;
+				MINI_STL::advance(mid,difference_type(n)-elems_before);
+				Uninitialized_copy(first,mid,Uninitialized_copy(start,position,new_start));
+				start = new_start;
+				MINI_STL::copy(mid,last,old_start);
+			}
+		}
+		else
+		{
+			iterator new_finish = reserve_elements_at_back(n);
+			iterator old_finish = finish;
+			const difference_type elems_after = difference_type(length)-elems_before;
+			position = finish-elems_after;
+			if (elems_after>difference_type(n))
+			{
+				iterator finish_n = finish-difference_type(n);
+				Uninitialized_copy(finish_n,finish,finish);
+				finish = new_finish;
+				MINI_STL::copy_backward(position,finish_n,old_finish);
+				MINI_STL::copy(first,last,position);
+			}
+			else
+			{
+				ForwardIterator mid = first;
+				MINI_STL::advance(mid,elems_after);
+				Uninitialized_copy(position,finish,Uninitialized_copy(mid,last,finish));
+				finish = new_finish;
+				MINI_STL::copy(first,mid,position);
+			}
+		}
+	}
+
+	template<class T,size_t BufBytes>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::reserve_elements_at_back(size_type n)
+	{
+		const size_type vacancies = (finish.M_last-finish.M_cur)-1;
+		if (n>vacancies)
+		{
+			new_elements_at_back(n-vacancies);
+		}
+		return finish+difference_type(n);
+	}
+
+	template<class T,size_t BufBytes>
+	typename deque<T,BufBytes>::iterator deque<T,BufBytes>::reserve_elements_at_front(size_type n)
+	{
+		const size_type vacancies = start.M_cur-start.M_first;
+		if (n>vacancies)
+		{
+			new_elements_at_front(n-vacancies);
+		}
+		return start-difference_type(n);
+	}
+
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::new_elements_at_back(size_type new_elements)
+	{
+		const size_type new_nodes = (new_elements+buffer_size()-1)/buffer_size();
+		reserve_map_at_back(new_nodes);
+		for (size_type i = 1; i <= new_nodes; ++i)
+		{
+			*(finish.M_node+i) = allocate_nodes();
+		}
+	}
+
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::new_elements_at_front(size_type new_elements)
+	{
+		const size_type new_nodes = (new_elements+buffer_size()-1)/buffer_size();
+		reserve_map_at_front(new_nodes);
+		for (size_type i = 1; i <= new_nodes; ++i)
+		{
+			*(start.M_node-i) = allocate_nodes();
+		}
+	}
+
+	template<class T,size_t BufBytes>
+	template<class InputIterator>
+	void deque<T,BufBytes>::append(InputIterator first,InputIterator last)
+	{
+		range_append(first,last,iterator_category(first));
+	}
+
+	template<class T,size_t BufBytes>
+	template<class InputIterator>
+	void deque<T,BufBytes>::range_append(InputIterator first,InputIterator last,input_iterator_tag)
+	{
+		for (;first!=last;++first)
+		{
+			push_back(*first);
+		}
+	}
+
+	template<class T,size_t BufBytes>
+	template<class ForwardIterator>
+	void deque<T,BufBytes>::range_append(ForwardIterator first,ForwardIterator last,forward_iterator_tag)
+	{
+		iterator new_finish = reserve_elements_at_back(MINI_STL::distance(first,last));
+		Uninitialized_copy(first,last,finish);
+		finish = new_finish;
+	}
+
+	template<class T,size_t BufBytes>
+	template<class InputIterator>
+	void deque<T,BufBytes>::prepend(InputIterator first,InputIterator last)
+	{
+		range_prepend(first,last,iterator_category(first));
+	}
+
+	//输入迭代器只能遍历一次,先收集再整体放到前端以保持顺序
+	template<class T,size_t BufBytes>
+	template<class InputIterator>
+	void deque<T,BufBytes>::range_prepend(InputIterator first,InputIterator last,input_iterator_tag)
+	{
+		deque temp(first,last);
+		range_prepend(temp.begin(),temp.end(),forward_iterator_tag());
+	}
+
+	template<class T,size_t BufBytes>
+	template<class ForwardIterator>
+	void deque<T,BufBytes>::range_prepend(ForwardIterator first,ForwardIterator last,forward_iterator_tag)
+	{
+		iterator new_start = reserve_elements_at_front(MINI_STL::distance(first,last));
+		Uninitialized_copy(first,last,new_start);
+		start = new_start;
+	}
+
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::pop_front_n(size_type n)
+	{
+		iterator new_start = start+difference_type(n);
+		destroy(start,new_start);
+		for (map_pointer cur = start.M_node; cur < new_start.M_node; ++cur)
+		{
+			deallocate_nodes(*cur);
+		}
+		start = new_start;
+	}
+
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::pop_back_n(size_type n)
+	{
+		iterator new_finish = finish-difference_type(n);
+		destroy(new_finish,finish);
+		for (map_pointer cur = new_finish.M_node+1; cur <= finish.M_node; ++cur)
+		{
+			deallocate_nodes(*cur);
+		}
+		finish = new_finish;
+	}
+
+	template<class T,size_t BufBytes>
+	void deque<T,BufBytes>::swap(deque& x)
 	{
 		using MINI_STL::swap;
 		swap(start,x.start);
 		swap(finish,x.finish);
 		swap(map,x.map);
 		swap(map_size,x.map_size);
+		for (size_type i = 0; i != max_spare_nodes; ++i)
+		{
+			swap(spare_nodes[i],x.spare_nodes[i]);
+		}
+		swap(spare_nums,x.spare_nums);
 	}
 
-	template<class T>
-	deque<T>& deque<T>::operator=(const deque& x)
+	template<class T,size_t BufBytes>
+	deque<T,BufBytes>& deque<T,BufBytes>::operator=(const deque& x)
 	{
 		const size_type len = size();
 		if (this != &x)
 		{
 			if (len > x.size())
 			{
-				erase(copy(x.begin(),x.end(),start),finish);
+				erase(MINI_STL::copy(x.begin(),x.end(),start),finish);
 			}
 			else
 			{
-				copy(x.begin(),x.begin()+difference_type(len),start);
+				MINI_STL::copy(x.begin(),x.begin()+difference_type(len),start);
 				const_iterator first = x.begin()+difference_type(len);
 				const_iterator last = x.end();
 				while (first!=last)
@@ -640,8 +929,8 @@ namespace MINI_STL
 	}
 
 
-	template<class T>
-	inline bool operator==(const deque<T>& x,const deque<T>& y)
+	template<class T,size_t BufBytes>
+	inline bool operator==(const deque<T,BufBytes>& x,const deque<T,BufBytes>& y)
 	{
 		if (y.size()!=x.size())
 		{
@@ -659,32 +948,32 @@ namespace MINI_STL
 		return first1==last1&&first2==last2;
 	}
 
-	template<class T>
-	inline bool operator!=(const deque<T>&x,const deque<T>& y)
+	template<class T,size_t BufBytes>
+	inline bool operator!=(const deque<T,BufBytes>&x,const deque<T,BufBytes>& y)
 	{
 		return !(x==y);
 	}
 
-	template<class T>
-	inline bool operator<(const deque<T>& x,const deque<T>& y)
+	template<class T,size_t BufBytes>
+	inline bool operator<(const deque<T,BufBytes>& x,const deque<T,BufBytes>& y)
 	{
 		return lexicographical_compare(x.begin(),x.end(),y.begin(),y.end());
 	}
 
-	template<class T>
-	inline bool operator>(const deque<T>& x,const deque<T>& y)
+	template<class T,size_t BufBytes>
+	inline bool operator>(const deque<T,BufBytes>& x,const deque<T,BufBytes>& y)
 	{
 		return y<x;
 	}
 
-	template<class T>
-	inline bool operator<=(const deque<T>& x,const deque<T>& y)
+	template<class T,size_t BufBytes>
+	inline bool operator<=(const deque<T,BufBytes>& x,const deque<T,BufBytes>& y)
 	{
 		return !(x>y);
 	}
 
-	template<class T>
-	inline bool operator>=(const deque<T>& x,const deque<T>& y)
+	template<class T,size_t BufBytes>
+	inline bool operator>=(const deque<T,BufBytes>& x,const deque<T,BufBytes>& y)
 	{
 		return !(x<y);
 	}
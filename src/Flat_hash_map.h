@@ -0,0 +1,77 @@
+#ifndef _MINI_STL_FLAT_HASH_MAP_H_
+#define _MINI_STL_FLAT_HASH_MAP_H_
+
+#include "Flat_hashtable.h"
+#include "Functional.h"
+#include "Hash_fcn.h"
+#include "Pair.h"
+
+namespace MINI_STL
+{
+	//元素为pair<const Key,T>,直接存放在flat_hashtable的槽中
+	template<class Key,class T,class HashFcn=hash<Key>,class EqualKey=equal_to<Key>>
+	class flat_hash_map
+	{
+	public:
+		typedef Key					key_type;
+		typedef T					data_type;
+		typedef T					mapped_type;
+		typedef pair<const Key,T>	value_type;
+
+	private:
+		typedef flat_hashtable<value_type,Key,HashFcn,selectFirst<value_type>,EqualKey> ht;
+		ht htable;
+
+	public:
+		typedef typename ht::hasher hasher;
+		typedef typename ht::key_equal key_equal;
+
+		typedef typename ht::size_type size_type;
+		typedef typename ht::difference_type difference_type;
+		typedef typename ht::pointer pointer;
+		typedef typename ht::const_pointer const_pointer;
+		typedef typename ht::reference reference;
+		typedef typename ht::const_reference const_reference;
+
+		typedef typename ht::iterator iterator;
+		typedef typename ht::const_iterator const_iterator;
+
+		flat_hash_map():htable(0,hasher(),key_equal()){}
+		explicit flat_hash_map(size_type n):htable(n,hasher(),key_equal()){}
+
+		size_type size()const{return htable.size();}
+		bool empty()const{return htable.empty();}
+		size_type capacity()const{return htable.capacity();}
+		void reserve(size_type n){htable.reserve(n);}
+
+		iterator begin(){return htable.begin();}
+		iterator end(){return htable.end();}
+		const_iterator begin()const{return htable.begin();}
+		const_iterator end()const{return htable.end();}
+
+		//命中时不构造临时的value_type
+		T& operator[](const key_type& k)
+		{
+			iterator it = htable.find(k);
+			if (it!=htable.end())
+			{
+				return (*it).second;
+			}
+			return (*(htable.insert_unique(value_type(k,T())).first)).second;
+		}
+
+		pair<iterator,bool> insert(const value_type& v){return htable.insert_unique(v);}
+
+		iterator find(const key_type& k){return htable.find(k);}
+		const_iterator find(const key_type& k)const{return htable.find(k);}
+		size_type count(const key_type& k)const{return htable.count(k);}
+
+		size_type erase(const key_type& k){return htable.erase(k);}
+		void erase(const_iterator position){htable.erase(position);}
+
+		void clear(){htable.clear();}
+		void swap(flat_hash_map& x){htable.swap(x.htable);}
+	};
+}
+
+#endif
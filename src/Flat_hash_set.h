@@ -0,0 +1,64 @@
+#ifndef _MINI_STL_FLAT_HASH_SET_H_
+#define _MINI_STL_FLAT_HASH_SET_H_
+
+#include "Flat_hashtable.h"
+#include "Functional.h"
+#include "Hash_fcn.h"
+#include "Pair.h"
+
+namespace MINI_STL
+{
+	//接口与hashset相同,底层为开放寻址的flat_hashtable
+	template<class Value,class HashFcn=hash<Value>,class EqualKey=equal_to<Value>>
+	class flat_hash_set
+	{
+	private:
+		typedef flat_hashtable<Value,Value,HashFcn,identity<Value>,EqualKey> ht;
+		ht htable;
+
+	public:
+		typedef typename ht::key_type key_type;
+		typedef typename ht::value_type value_type;
+		typedef typename ht::hasher hasher;
+		typedef typename ht::key_equal key_equal;
+
+		typedef typename ht::size_type size_type;
+		typedef typename ht::difference_type difference_type;
+		typedef typename ht::const_pointer pointer;
+		typedef typename ht::const_pointer const_pointer;
+		typedef typename ht::const_reference reference;
+		typedef typename ht::const_reference const_reference;
+
+		typedef typename ht::const_iterator iterator;
+		typedef typename ht::const_iterator const_iterator;
+
+		flat_hash_set():htable(0,hasher(),key_equal()){}
+		explicit flat_hash_set(size_type n):htable(n,hasher(),key_equal()){}
+
+		size_type size()const{return htable.size();}
+		bool empty()const{return htable.empty();}
+		size_type capacity()const{return htable.capacity();}
+		void reserve(size_type n){htable.reserve(n);}
+
+		iterator begin()const{return htable.begin();}
+		iterator end()const{return htable.end();}
+
+		pair<iterator,bool> insert(const value_type& v)
+		{
+			pair<typename ht::iterator,bool> p = htable.insert_unique(v);
+			return pair<iterator,bool>(p.first,p.second);
+		}
+
+		const_iterator find(const key_type& k)const{return htable.find(k);}
+		size_type count(const key_type& k)const{return htable.count(k);}
+		bool isContain(const key_type& k)const{return htable.count(k)!=0;}
+
+		size_type erase(const key_type& k){return htable.erase(k);}
+		void erase(iterator position){htable.erase(position);}
+
+		void clear(){htable.clear();}
+		void swap(flat_hash_set& x){htable.swap(x.htable);}
+	};
+}
+
+#endif
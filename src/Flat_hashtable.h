@@ -0,0 +1,467 @@
+#ifndef _MINI_STL_FLAT_HASHTABLE_H_
+#define _MINI_STL_FLAT_HASHTABLE_H_
+
+#include "Algorithm.h"
+#include "Allocator.h"
+#include "Construct.h"
+#include "Hash_fcn.h"
+#include "Iterator.h"
+#include "Pair.h"
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#define MINI_STL_FLAT_HASH_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace MINI_STL
+{
+	/************************************************************************/
+	/*	flat_hashtable:开放寻址哈希表(SwissTable式控制字节)
+		1.元素直接存放在连续的槽数组中,不为每个元素分配结点
+		2.每个槽对应一个控制字节:空/已删除为负数,占用时存哈希值的低7位(h2)
+		3.查找时一次比较16个控制字节(SSE2),只有h2相同的槽才比较键,遇到空槽即停止
+		4.容量为2的幂,按组做三角探测;负载超过7/8时扩容为两倍,墓碑过多时原地重建
+		5.插入可能引起重建,会使所有迭代器和元素指针失效
+	*/
+	/************************************************************************/
+	typedef signed char flat_ctrl_t;
+
+	enum
+	{
+		flat_ctrl_empty		= -128,
+		flat_ctrl_deleted	= -2,
+		flat_group_width	= 16
+	};
+
+	//最低的置位位置,x不能为0
+	inline unsigned flat_lowest_bit(unsigned x)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index,x);
+		return index;
+#else
+		return __builtin_ctz(x);
+#endif
+	}
+
+	inline void flat_prefetch(const void* p)
+	{
+#ifdef MINI_STL_FLAT_HASH_SSE2
+		_mm_prefetch(static_cast<const char*>(p),_MM_HINT_T0);
+#else
+		__builtin_prefetch(p);
+#endif
+	}
+
+	//一组16个控制字节,各match返回按位表示的匹配槽
+	struct flat_group
+	{
+#ifdef MINI_STL_FLAT_HASH_SSE2
+		__m128i ctrl;
+
+		explicit flat_group(const flat_ctrl_t* p):ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))){}
+
+		unsigned match(flat_ctrl_t h2)const
+		{
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2),ctrl));
+		}
+		//空和已删除的控制字节都是负数,符号位即结果
+		unsigned match_empty_or_deleted()const
+		{
+			return _mm_movemask_epi8(ctrl);
+		}
+#else
+		const flat_ctrl_t* ctrl;
+
+		explicit flat_group(const flat_ctrl_t* p):ctrl(p){}
+
+		unsigned match(flat_ctrl_t h2)const
+		{
+			unsigned mask = 0;
+			for (int i = 0; i != flat_group_width; ++i)
+			{
+				mask |= unsigned(ctrl[i]==h2)<<i;
+			}
+			return mask;
+		}
+		unsigned match_empty_or_deleted()const
+		{
+			unsigned mask = 0;
+			for (int i = 0; i != flat_group_width; ++i)
+			{
+				mask |= unsigned(ctrl[i]<0)<<i;
+			}
+			return mask;
+		}
+#endif
+		unsigned match_empty()const{return match(flat_ctrl_empty);}
+	};
+
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
+	class flat_hashtable;
+
+	template<class Table,class Value>
+	struct flat_hashtable_iterator
+	{
+		typedef forward_iterator_tag	iterator_category;
+		typedef Value					value_type;
+		typedef Value*					pointer;
+		typedef Value&					reference;
+		typedef size_t					size_type;
+		typedef ptrdiff_t				difference_type;
+
+		Table* ht;
+		size_type index;
+
+		flat_hashtable_iterator():ht(0),index(0){}
+		flat_hashtable_iterator(Table* t,size_type i):ht(t),index(i){}
+		template<class T,class V>
+		flat_hashtable_iterator(const flat_hashtable_iterator<T,V>& x):ht(x.ht),index(x.index){}
+
+		reference operator*()const{return ht->slots[index];}
+		pointer operator->()const{return &(operator*());}
+
+		flat_hashtable_iterator& operator++()
+		{
+			index = ht->next_full(index+1);
+			return *this;
+		}
+		flat_hashtable_iterator operator++(int)
+		{
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		bool operator==(const flat_hashtable_iterator& x)const{return index==x.index;}
+		bool operator!=(const flat_hashtable_iterator& x)const{return index!=x.index;}
+	};
+
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
+	class flat_hashtable
+	{
+	public:
+		typedef HashFcn		hasher;
+		typedef EqualKey	key_equal;
+		typedef Value		value_type;
+		typedef Key			key_type;
+
+		typedef size_t				size_type;
+		typedef ptrdiff_t			difference_type;
+		typedef value_type*			pointer;
+		typedef const value_type*	const_pointer;
+		typedef value_type&			reference;
+		typedef const value_type&	const_reference;
+
+		typedef flat_hashtable_iterator<flat_hashtable,Value>				iterator;
+		typedef flat_hashtable_iterator<const flat_hashtable,const Value>	const_iterator;
+		friend struct flat_hashtable_iterator<flat_hashtable,Value>;
+		friend struct flat_hashtable_iterator<const flat_hashtable,const Value>;
+
+	private:
+		typedef Allocator<Value>		dataAllocator;
+		typedef Allocator<flat_ctrl_t>	ctrlAllocator;
+
+		hasher		hash;
+		key_equal	equals;
+		ExtractKey	get_key;
+		//ctrl末尾多出flat_group_width个字节,复制开头的控制字节,使任意位置都能整组读取
+		flat_ctrl_t* ctrl;
+		Value* slots;
+		size_type cap;			//槽数,0或不小于flat_group_width的2的幂
+		size_type ele_nums;
+		size_type growth_left;	//不触发重建还能占用的空槽数
+
+		static size_type max_load(size_type n){return n-n/8;}
+		static flat_ctrl_t h2(size_t h){return flat_ctrl_t(h&0x7F);}
+		size_t hash_of(const key_type& k)const{return hash_mix(hash(k));}
+		size_type probe_start(size_t h)const{return (h>>7)&(cap-1);}
+
+		void set_ctrl(size_type i,flat_ctrl_t c)
+		{
+			ctrl[i] = c;
+			if (i<flat_group_width)
+			{
+				ctrl[cap+i] = c;
+			}
+		}
+
+		void allocate_slots(size_type n)
+		{
+			cap = n;
+			ele_nums = 0;
+			if (n==0)
+			{
+				ctrl = 0;
+				slots = 0;
+				growth_left = 0;
+				return;
+			}
+			ctrl = ctrlAllocator::allocate(n+flat_group_width);
+			slots = dataAllocator::allocate(n);
+			MINI_STL::fill(ctrl,ctrl+n+flat_group_width,flat_ctrl_t(flat_ctrl_empty));
+			growth_left = max_load(n);
+		}
+
+		void destroy_and_deallocate()
+		{
+			if (cap==0)
+			{
+				return;
+			}
+			for (size_type i = 0; i != cap; ++i)
+			{
+				if (ctrl[i]>=0)
+				{
+					destroy(slots+i);
+				}
+			}
+			ctrlAllocator::deallocate(ctrl,cap+flat_group_width);
+			dataAllocator::deallocate(slots,cap);
+		}
+
+		//从i起第一个被占用的槽,没有则返回cap
+		size_type next_full(size_type i)const
+		{
+			while (i<cap && ctrl[i]<0)
+			{
+				++i;
+			}
+			return i;
+		}
+
+		//返回键为k的槽,没有则返回cap
+		size_type find_index(const key_type& k,size_t h)const
+		{
+			if (cap==0)
+			{
+				return 0;
+			}
+			const size_type mask = cap-1;
+			const flat_ctrl_t tag = h2(h);
+			size_type pos = probe_start(h);
+			//命中的槽多半在第一组内,与控制字节并行取入缓存
+			flat_prefetch(slots+pos);
+			for (size_type step = flat_group_width; ; step += flat_group_width)
+			{
+				flat_group g(ctrl+pos);
+				for (unsigned m = g.match(tag); m; m &= m-1)
+				{
+					const size_type i = (pos+flat_lowest_bit(m))&mask;
+					if (equals(get_key(slots[i]),k))
+					{
+						return i;
+					}
+				}
+				if (g.match_empty())
+				{
+					return cap;
+				}
+				pos = (pos+step)&mask;
+			}
+		}
+
+		//探测序列上第一个空或已删除的槽
+		size_type find_insert_slot(size_t h)const
+		{
+			const size_type mask = cap-1;
+			size_type pos = probe_start(h);
+			for (size_type step = flat_group_width; ; step += flat_group_width)
+			{
+				const unsigned m = flat_group(ctrl+pos).match_empty_or_deleted();
+				if (m)
+				{
+					return (pos+flat_lowest_bit(m))&mask;
+				}
+				pos = (pos+step)&mask;
+			}
+		}
+
+		//把全部元素搬到n个槽的新表,同时清除墓碑
+		void rehash_to(size_type n)
+		{
+			flat_ctrl_t* old_ctrl = ctrl;
+			Value* old_slots = slots;
+			const size_type old_cap = cap;
+			const size_type old_nums = ele_nums;
+			allocate_slots(n);
+			for (size_type i = 0; i != old_cap; ++i)
+			{
+				if (old_ctrl[i]>=0)
+				{
+					const size_t h = hash_of(get_key(old_slots[i]));
+					const size_type j = find_insert_slot(h);
+					set_ctrl(j,h2(h));
+					construct(slots+j,old_slots[i]);
+					destroy(old_slots+i);
+				}
+			}
+			ele_nums = old_nums;
+			growth_left -= old_nums;
+			if (old_cap)
+			{
+				ctrlAllocator::deallocate(old_ctrl,old_cap+flat_group_width);
+				dataAllocator::deallocate(old_slots,old_cap);
+			}
+		}
+
+		//没有可用的空槽时重建:墓碑占多数则原地重建,否则扩容为两倍
+		void make_room()
+		{
+			if (cap==0)
+			{
+				rehash_to(flat_group_width);
+			}
+			else if (ele_nums<=max_load(cap)/2)
+			{
+				rehash_to(cap);
+			}
+			else
+			{
+				rehash_to(cap*2);
+			}
+		}
+
+		void erase_at(size_type i)
+		{
+			destroy(slots+i);
+			set_ctrl(i,flat_ctrl_deleted);
+			--ele_nums;
+		}
+
+	public:
+		flat_hashtable(size_type n,const HashFcn& hfcn,const key_equal& kequal,const ExtractKey& ekey=ExtractKey())
+			:hash(hfcn),equals(kequal),get_key(ekey)
+		{
+			allocate_slots(0);
+			reserve(n);
+		}
+		flat_hashtable(const flat_hashtable& x)
+			:hash(x.hash),equals(x.equals),get_key(x.get_key)
+		{
+			allocate_slots(0);
+			reserve(x.ele_nums);
+			for (const_iterator it = x.begin(); it != x.end(); ++it)
+			{
+				insert_unique(*it);
+			}
+		}
+		flat_hashtable& operator=(const flat_hashtable& x)
+		{
+			if (this!=&x)
+			{
+				flat_hashtable temp(x);
+				swap(temp);
+			}
+			return *this;
+		}
+		~flat_hashtable(){destroy_and_deallocate();}
+
+		iterator begin(){return iterator(this,next_full(0));}
+		iterator end(){return iterator(this,cap);}
+		const_iterator begin()const{return const_iterator(this,next_full(0));}
+		const_iterator end()const{return const_iterator(this,cap);}
+
+		size_type size()const{return ele_nums;}
+		bool empty()const{return ele_nums==0;}
+		size_type capacity()const{return cap;}
+
+		//保证插入n个元素期间不再重建
+		void reserve(size_type n)
+		{
+			size_type want = cap ? cap : size_type(flat_group_width);
+			while (max_load(want)<n)
+			{
+				want *= 2;
+			}
+			//槽数够但墓碑占用了空位时,也原地重建
+			if (want>cap || (n>ele_nums && growth_left<n-ele_nums))
+			{
+				rehash_to(want);
+			}
+		}
+
+		pair<iterator,bool> insert_unique(const value_type& v)
+		{
+			const size_t h = hash_of(get_key(v));
+			size_type i = find_index(get_key(v),h);
+			if (i!=cap)
+			{
+				return pair<iterator,bool>(iterator(this,i),false);
+			}
+			if (cap==0 || growth_left==0)
+			{
+				make_room();
+			}
+			i = find_insert_slot(h);
+			if (ctrl[i]==flat_ctrl_empty)
+			{
+				--growth_left;
+			}
+			construct(slots+i,v);
+			set_ctrl(i,h2(h));
+			++ele_nums;
+			return pair<iterator,bool>(iterator(this,i),true);
+		}
+
+		iterator find(const key_type& k)
+		{
+			return iterator(this,find_index(k,hash_of(k)));
+		}
+		const_iterator find(const key_type& k)const
+		{
+			return const_iterator(this,find_index(k,hash_of(k)));
+		}
+		size_type count(const key_type& k)const
+		{
+			return find_index(k,hash_of(k))!=cap ? 1 : 0;
+		}
+
+		size_type erase(const key_type& k)
+		{
+			const size_type i = find_index(k,hash_of(k));
+			if (i==cap)
+			{
+				return 0;
+			}
+			erase_at(i);
+			return 1;
+		}
+		void erase(const_iterator position){erase_at(position.index);}
+
+		//析构全部元素,保留槽数组
+		void clear()
+		{
+			for (size_type i = 0; i != cap; ++i)
+			{
+				if (ctrl[i]>=0)
+				{
+					destroy(slots+i);
+				}
+			}
+			if (cap)
+			{
+				MINI_STL::fill(ctrl,ctrl+cap+flat_group_width,flat_ctrl_t(flat_ctrl_empty));
+			}
+			ele_nums = 0;
+			growth_left = max_load(cap);
+		}
+
+		void swap(flat_hashtable& x)
+		{
+			MINI_STL::swap(hash,x.hash);
+			MINI_STL::swap(equals,x.equals);
+			MINI_STL::swap(get_key,x.get_key);
+			MINI_STL::swap(ctrl,x.ctrl);
+			MINI_STL::swap(slots,x.slots);
+			MINI_STL::swap(cap,x.cap);
+			MINI_STL::swap(ele_nums,x.ele_nums);
+			MINI_STL::swap(growth_left,x.growth_left);
+		}
+	};
+}
+
+#endif
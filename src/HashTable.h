@@ -4,32 +4,100 @@
 #include "Algorithm.h"
 #include "Allocator.h"
 #include "Construct.h"
+#include "Hash_fcn.h"
 #include "Iterator.h"
 #include "Vector.h"
 #include "Pair.h"
 
 namespace MINI_STL
 {
-	template<class Value>
+	enum { num_primes = 28 };
+
+	static const unsigned long prime_list[num_primes] =
+	{
+	  53ul,         97ul,         193ul,       389ul,       769ul,
+	  1543ul,       3079ul,       6151ul,      12289ul,     24593ul,
+	  49157ul,      98317ul,      196613ul,    393241ul,    786433ul,
+	  1572869ul,    3145739ul,    6291469ul,   12582917ul,  25165843ul,
+	  50331653ul,   100663319ul,  201326611ul, 402653189ul, 805306457ul, 
+	  1610612741ul, 3221225473ul, 4294967291ul
+	};
+
+	inline unsigned long next_prime(unsigned long n)
+	{
+		const unsigned long* first = prime_list;
+		const unsigned long* last = prime_list + (int)num_primes;
+		const unsigned long* pos = lower_bound(first,last,n);
+		return pos==last?*(last-1):*pos;
+	}
+
+	/************************************************************************/
+	/*	桶数策略:bucket_count(n)给出不少于n的桶数,index(h,n)把哈希值映射到桶
+		1.prime_bucket_policy:桶数取质数,用%取桶,对恒等哈希也能分散,但每次查找都有一次除法
+		2.pow2_bucket_policy:桶数取2的幂,先用hash_mix扩散各位再按位与取桶,没有除法
+	*/
+	/************************************************************************/
+	struct prime_bucket_policy
+	{
+		static size_t bucket_count(size_t n){return next_prime(n);}
+		static size_t index(size_t h,size_t n){return h%n;}
+	};
+
+	struct pow2_bucket_policy
+	{
+		static size_t bucket_count(size_t n)
+		{
+			size_t m = 8;
+			while (m<n)
+			{
+				m <<= 1;
+			}
+			return m;
+		}
+		static size_t index(size_t h,size_t n){return hash_mix(h)&(n-1);}
+	};
+
+	/************************************************************************/
+	/*	hashtable_node:CacheHash为true时结点额外保存完整的哈希值
+		1.重建/迁移/遍历时直接用保存的哈希值定位桶,不必对键重新求哈希
+		2.查找时先比较哈希值,相等才调用EqualKey,字符串等比较代价高的键可省去大部分比较
+		3.代价是每个结点多一个size_t,键是整数等廉价类型时不宜开启
+	*/
+	/************************************************************************/
+	template<class Value,bool CacheHash>
 	struct hashtable_node
 	{
 		hashtable_node* next;
 		Value val;
+
+		void set_hash(size_t){}
+		size_t get_hash()const{return 0;}
+	};
+
+	template<class Value>
+	struct hashtable_node<Value,true>
+	{
+		hashtable_node* next;
+		size_t hash_code;
+		Value val;
+
+		void set_hash(size_t h){hash_code = h;}
+		size_t get_hash()const{return hash_code;}
 	};
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy=prime_bucket_policy,bool CacheHash=false,class Alloc=alloc>
 	class hashtable;
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
 	struct hashtable_const_iterator;
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
 	struct hashtable_iterator
 	{
-		typedef hashtable<Value,Key,HashFcn,ExtractKey,EqualKey> hashtable;
-		typedef hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey> iterator;
-		typedef hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey> const_iterator;
-		typedef hashtable_node<Value> node;
+		typedef hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> hashtable;
+		typedef hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> iterator;
+		typedef hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> const_iterator;
+		typedef hashtable_node<Value,CacheHash> node;
 
 		typedef forward_iterator_tag iterator_category;
 		typedef Value value_type;
@@ -54,13 +122,13 @@ namespace MINI_STL
 		bool operator!=(const iterator& it)const{return cur!=it.cur;}
 	};
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
 	struct hashtable_const_iterator
 	{
-		typedef hashtable<Value,Key,HashFcn,ExtractKey,EqualKey> hashtable;
-		typedef hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey> iterator;
-		typedef hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey> const_iterator;
-		typedef hashtable_node<Value> node;
+		typedef hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> hashtable;
+		typedef hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> iterator;
+		typedef hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> const_iterator;
+		typedef hashtable_node<Value,CacheHash> node;
 
 		typedef forward_iterator_tag iterator_category;
 		typedef Value value_type;
@@ -86,31 +154,11 @@ namespace MINI_STL
 		bool operator!=(const const_iterator& it)const{return cur!=it.cur;}
 	};
 
-	enum { num_primes = 28 };
-
-	static const unsigned long prime_list[num_primes] =
-	{
-	  53ul,         97ul,         193ul,       389ul,       769ul,
-	  1543ul,       3079ul,       6151ul,      12289ul,     24593ul,
-	  49157ul,      98317ul,      196613ul,    393241ul,    786433ul,
-	  1572869ul,    3145739ul,    6291469ul,   12582917ul,  25165843ul,
-	  50331653ul,   100663319ul,  201326611ul, 402653189ul, 805306457ul, 
-	  1610612741ul, 3221225473ul, 4294967291ul
-	};
-
-	inline unsigned long next_prime(unsigned long n)
-	{
-		const unsigned long* first = prime_list;
-		const unsigned long* last = prime_list + (int)num_primes;
-		const unsigned long* pos = lower_bound(first,last,n);
-		return pos==last?*(last-1):*pos;
-	}
-
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
-	bool operator==(const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey>& ht1,
-					const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey>& ht2);
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
+	bool operator==(const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>& ht1,
+					const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>& ht2);
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
 	class hashtable
 	{
 	public:
@@ -127,23 +175,25 @@ namespace MINI_STL
 		typedef const value_type& const_reference;
 
 	private:
-		typedef hashtable_node<Value> node;
+		typedef hashtable_node<Value,CacheHash> node;
 	public:
-		typedef Allocator<node> node_allocator;
-		typedef hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey> 	iterator;
-		typedef hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>	const_iterator;
-		friend struct hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>;
-		friend struct hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>;
-		template <class VL, class KY, class HF, class EX, class EQ>
-  		friend bool operator== (const hashtable<VL, KY, HF, EX, EQ>&,
-                          		const hashtable<VL, KY, HF, EX, EQ>&);
+		typedef Allocator<node,Alloc> node_allocator;
+		typedef vector<node*,Allocator<node*,Alloc>> bucket_vector;
+		typedef hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> 	iterator;
+		typedef hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>	const_iterator;
+		friend struct hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>;
+		friend struct hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>;
+		template <class VL, class KY, class HF, class EX, class EQ, class BP, bool CH, class AL>
+  		friend bool operator== (const hashtable<VL, KY, HF, EX, EQ, BP, CH, AL>&,
+                          		const hashtable<VL, KY, HF, EX, EQ, BP, CH, AL>&);
 	private:
 		node* getNode(){return node_allocator::allocate();}
 		void putNode(node* p){node_allocator::deallocate(p);}
-		node* new_node(const value_type& v)
+		node* new_node(const value_type& v,size_type h)
 		{
 			node* n = getNode();
 			n->next = nullptr;
+			n->set_hash(h);
 			construct(&n->val,v);
 			return n;
 		}
@@ -154,36 +204,57 @@ namespace MINI_STL
 		}
 
 	private:
+		enum { rehash_step = 8 };	//渐进式重建时每次插入迁移的旧桶数
+
 		hasher 	hash;
 		key_equal 	equals;
 		ExtractKey 	get_key;
-		vector<node*>	buckets;
+		bucket_vector	buckets;
 		size_type 	ele_nums;
+		float	max_load;	//平均每个桶的元素数超过它时扩容
+		//渐进式重建:迁移期间旧桶数组中下标不小于migrate_pos的桶尚未迁移
+		bucket_vector	old_buckets;
+		size_type	migrate_pos;
+		bool	incremental;
 
 	public:
 		hashtable(size_type n,const HashFcn& hfcn,const key_equal& kequal,const ExtractKey& ekey)
-		:hash(hfcn),equals(kequal),get_key(ekey),buckets(),ele_nums(0)
+		:hash(hfcn),equals(kequal),get_key(ekey),buckets(),ele_nums(0),max_load(1.0f),old_buckets(),migrate_pos(0),incremental(false)
 		{
 			initialize_buckets(n);
 		}
 
 		hashtable(size_type n,const HashFcn& hfcn,const key_equal& kequal)
-		:hash(hfcn),equals(kequal),get_key(ExtractKey()),buckets(),ele_nums(0)
+		:hash(hfcn),equals(kequal),get_key(ExtractKey()),buckets(),ele_nums(0),max_load(1.0f),old_buckets(),migrate_pos(0),incremental(false)
 		{
 			initialize_buckets(n);
 		}
 
-		hashtable(const hashtable& htable):hash(htable.hash),equals(htable.key_equal).get_key(htable.get_key),buckets(),ele_nums(htable.ele_nums)
+		hashtable(const hashtable& htable)
+		:hash(htable.hash),equals(htable.equals),get_key(htable.get_key),buckets(),ele_nums(htable.ele_nums),
+		 max_load(htable.max_load),old_buckets(),migrate_pos(htable.migrate_pos),incremental(htable.incremental)
+		{
+			buckets_copy_from(buckets,htable.buckets);
+			buckets_copy_from(old_buckets,htable.old_buckets);
+		}
+
+		hashtable& operator=(const hashtable& htable)
 		{
-			buckets_copy_from(ht.buckets);
+			if (this!=&htable)
+			{
+				hashtable temp(htable);
+				swap(temp);
+			}
+			return *this;
 		}
 
 		~hashtable() {clear();}
 
 		size_type erase(const key_type& k)
 		{
-			const size_type index = bucket_num_by_key(k);
-			node* first = buckets[index];
+			const size_type h = hash(k);
+			node*& head = bucket_ref(h);
+			node* first = head;
 			size_type erased = 0;
 			if(first)
 			{
@@ -191,7 +262,7 @@ namespace MINI_STL
 				node* next = cur->next;
 				while(next)
 				{
-					if(equals(get_key(next->val),k))
+					if(node_matches(next,k,h))
 					{
 						cur->next = next->next;
 						delete_node(next);
@@ -205,9 +276,9 @@ namespace MINI_STL
 						next = next->next;
 					}
 				}
-				if (equals(get_key(first->val),k))
+				if (node_matches(first,k,h))
 				{
-					buckets[index] = first->next;
+					head = first->next;
 					delete_node(first);
 					++erased;
 					--ele_nums;
@@ -219,246 +290,545 @@ namespace MINI_STL
 		pair<iterator,bool> insert_unique(const value_type& v)
 		{
 			resize(ele_nums+1);
+			migrate_step();
 			return insert_unique_noresize(v);
 		}
 
-		iterator find(const key_type& k)
+		//允许键重复,相等的键在桶中相邻
+		iterator insert_equal(const value_type& v)
 		{
-			auto index = bucket_num_by_key(k);
-			node* first = buckets[index];
-			while(first!=nullptr && !equals(k,get_key(first->val)))
+			resize(ele_nums+1);
+			migrate_step();
+			return insert_equal_noresize(v);
+		}
+
+		template<class InputIterator>
+		void insert_unique(InputIterator first,InputIterator last)
+		{
+			for(;first!=last;++first)
 			{
-				first = first->next;
+				insert_unique(*first);
 			}
-			return iterator(first,this);
 		}
 
-		const_iterator find(const key_type& k)const
+		template<class InputIterator>
+		void insert_equal(InputIterator first,InputIterator last)
 		{
-			auto index = bucket_num_by_key(k);
-			node* first = buckets[index];
-			while(first!=nullptr && !equals(k,get_key(first->val)))
+			for(;first!=last;++first)
 			{
-				first = first->next;
+				insert_equal(*first);
 			}
-			return const_iterator(first,this);
 		}
 
-		size_type size()const{return ele_nums;}
-		bool empty()const{return ele_nums==0;}
+		//按位置删除不迁移旧桶,遍历中删除不会打乱顺序
+		void erase(const_iterator position)
+		{
+			node* cur = const_cast<node*>(position.cur);
+			if (cur)
+			{
+				node** link = &bucket_ref(node_hash(cur));
+				while(*link!=cur)
+				{
+					link = &(*link)->next;
+				}
+				*link = cur->next;
+				delete_node(cur);
+				--ele_nums;
+			}
+		}
 
-		iterator begin()
+		//删除[first,last),每条链只查找一次前驱
+		void erase(const_iterator first,const_iterator last)
 		{
-			for(auto index=0;index<buckets.size();++index)
+			node* cur = const_cast<node*>(first.cur);
+			while(cur!=last.cur)
 			{
-				if (buckets[index])
+				node** link = &bucket_ref(node_hash(cur));
+				while(*link!=cur)
 				{
-					return iterator(buckets[index],this);
+					link = &(*link)->next;
+				}
+				while(cur!=last.cur && cur->next!=nullptr)
+				{
+					*link = cur->next;
+					delete_node(cur);
+					--ele_nums;
+					cur = *link;
+				}
+				if (cur!=last.cur)
+				{
+					//链尾结点:删除前先求出下一个桶中的结点
+					node* next = next_node(cur);
+					*link = nullptr;
+					delete_node(cur);
+					--ele_nums;
+					cur = next;
 				}
 			}
-			return end();
 		}
 
-		const_iterator begin() const
+		iterator find(const key_type& k)
+		{
+			return iterator(find_node(k),this);
+		}
+
+		const_iterator find(const key_type& k)const
 		{
-			for(auto index=0;index<buckets.size();++index)
+			return const_iterator(find_node(k),this);
+		}
+
+		size_type count(const key_type& k)const
+		{
+			const size_type h = hash(k);
+			size_type result = 0;
+			for(const node* cur = bucket_head(h);cur!=nullptr;cur=cur->next)
 			{
-				if (buckets[index])
+				if (node_matches(cur,k,h))
 				{
-					return const_iterator(buckets[index],this);
+					++result;
 				}
 			}
-			return end();
+			return result;
+		}
+
+		pair<iterator,iterator> equal_range(const key_type& k)
+		{
+			const pair<node*,node*> r = equal_range_node(k);
+			return pair<iterator,iterator>(iterator(r.first,this),iterator(r.second,this));
+		}
+
+		pair<const_iterator,const_iterator> equal_range(const key_type& k)const
+		{
+			const pair<node*,node*> r = equal_range_node(k);
+			return pair<const_iterator,const_iterator>(const_iterator(r.first,this),const_iterator(r.second,this));
 		}
 
+		size_type size()const{return ele_nums;}
+		bool empty()const{return ele_nums==0;}
+
+		iterator begin() {return iterator(first_node(),this);}
+		const_iterator begin() const {return const_iterator(first_node(),this);}
+
 		iterator end() {return iterator(nullptr,this);}
 		const_iterator end()const {return const_iterator(nullptr,this);}
 
+		/************************************************************************/
+		/*	渐进式重建
+			1.开启后扩容只分配新桶数组,旧桶数组保留,每次插入从旧数组迁移rehash_step个桶
+			2.键在旧数组中的桶尚未迁移时仍在旧数组,否则在新数组,查找只需看一个桶
+			3.下次扩容前迁移必然已完成(插入次数远多于旧桶数/rehash_step),单次操作的耗时有上界
+			4.查找和删除都不迁移,遍历中按键或按位置删除只使被删元素的迭代器失效
+		*/
+		/************************************************************************/
+		void set_incremental_rehash(bool on)
+		{
+			if (!on)
+			{
+				migrate_buckets(old_buckets.size());
+			}
+			incremental = on;
+		}
+		bool incremental_rehash()const{return incremental;}
+		bool rehashing()const{return !old_buckets.empty();}
+
+		//迁移期间不含旧桶数组
+		size_type bucket_count()const{return buckets.size();}
+		float load_factor()const{return float(ele_nums)/float(buckets.size());}
+		float max_load_factor()const{return max_load;}
+		//调小后若当前负载已超出则立即扩容;非正数与NaN被忽略
+		void max_load_factor(float z)
+		{
+			if (!(z>0))
+			{
+				return;
+			}
+			max_load = z;
+			resize(ele_nums);
+		}
+		//桶数调整为不少于n且能容纳现有元素的最小值,可以缩小;总是一次性完成
+		void rehash(size_type n)
+		{
+			rebuild(BucketPolicy::bucket_count(max(n,min_buckets_for(ele_nums))));
+		}
+		//之后插入到共n个元素都不会再扩容
+		void reserve(size_type n)
+		{
+			const size_type need = min_buckets_for(n);
+			if (need>buckets.size())
+			{
+				rebuild(BucketPolicy::bucket_count(need));
+			}
+		}
+
+		void clear()
+		{
+			clear_buckets(buckets);
+			clear_buckets(old_buckets);
+			bucket_vector().swap(old_buckets);
+			migrate_pos = 0;
+			ele_nums = 0;
+		}
+
+		void swap(hashtable& ht)
+		{
+			MINI_STL::swap(hash,ht.hash);
+			MINI_STL::swap(equals,ht.equals);
+			MINI_STL::swap(get_key,ht.get_key);
+			buckets.swap(ht.buckets);
+			MINI_STL::swap(ele_nums,ht.ele_nums);
+			MINI_STL::swap(max_load,ht.max_load);
+			old_buckets.swap(ht.old_buckets);
+			MINI_STL::swap(migrate_pos,ht.migrate_pos);
+			MINI_STL::swap(incremental,ht.incremental);
+		}
+
 	private:
+		//容纳n个元素且不超过max_load所需的桶数
+		size_type min_buckets_for(size_type n)const
+		{
+			size_type b = size_type(double(n)/max_load);
+			while (double(b)*max_load<double(n))
+			{
+				++b;
+			}
+			return b;
+		}
+
 		void initialize_buckets(size_type n)
 		{
-			const size_type num = next_prime(n);
+			const size_type num = BucketPolicy::bucket_count(min_buckets_for(n));
 			buckets.reserve(num);
 			buckets.insert(buckets.end(),num,(node*)0);
 		}
-		size_type bucket_num_key(const key_type& k,size_type n)const
+		//结点的哈希值,缓存时不再调用hasher
+		size_type node_hash(const node* n)const
+		{
+			return CacheHash ? n->get_hash() : hash(get_key(n->val));
+		}
+		//缓存时先比较哈希值,不等则不必调用equals
+		bool node_matches(const node* n,const key_type& k,size_type h)const
+		{
+			return (!CacheHash || n->get_hash()==h) && equals(get_key(n->val),k);
+		}
+		size_type bucket_num_node(const node* n,size_type num)const
+		{
+			return BucketPolicy::index(node_hash(n),num);
+		}
+
+		//哈希值为h的键所在的桶
+		node*& bucket_ref(size_type h)
 		{
-			return hash(k)%n;
+			if (!old_buckets.empty())
+			{
+				const size_type old_index = BucketPolicy::index(h,old_buckets.size());
+				if (old_index>=migrate_pos)
+				{
+					return old_buckets[old_index];
+				}
+			}
+			return buckets[BucketPolicy::index(h,buckets.size())];
+		}
+		node* bucket_head(size_type h)const
+		{
+			return const_cast<hashtable*>(this)->bucket_ref(h);
+		}
+
+		node* find_node(const key_type& k)const
+		{
+			const size_type h = hash(k);
+			node* first = bucket_head(h);
+			while(first!=nullptr && !node_matches(first,k,h))
+			{
+				first = first->next;
+			}
+			return first;
+		}
+
+		//相等的键在链中相邻,找到第一个后顺链走到第一个不相等的结点
+		pair<node*,node*> equal_range_node(const key_type& k)const
+		{
+			const size_type h = hash(k);
+			for(node* first = bucket_head(h);first!=nullptr;first=first->next)
+			{
+				if (node_matches(first,k,h))
+				{
+					node* last = first;
+					while(last->next!=nullptr && node_matches(last->next,k,h))
+					{
+						last = last->next;
+					}
+					return pair<node*,node*>(first,next_node(last));
+				}
+			}
+			return pair<node*,node*>(nullptr,nullptr);
+		}
+
+		static node* first_in(const bucket_vector& buck,size_type index)
+		{
+			for(;index<buck.size();++index)
+			{
+				if (buck[index])
+				{
+					return buck[index];
+				}
+			}
+			return nullptr;
 		}
-		size_type bucket_num_val(const value_type& v,size_type n) const
+
+		//遍历顺序:先新桶数组,再旧桶数组中未迁移的部分
+		node* first_node()const
 		{
-			return bucket_num_key(get_key(v),n);
+			node* first = first_in(buckets,0);
+			return first ? first : first_in(old_buckets,migrate_pos);
 		}
-		size_type bucket_num_by_key(const key_type& k)const
+		node* next_node(const node* cur)const
 		{
-			return bucket_num_key(k,buckets.size());
+			if (cur->next)
+			{
+				return cur->next;
+			}
+			const size_type h = node_hash(cur);
+			if (!old_buckets.empty())
+			{
+				const size_type old_index = BucketPolicy::index(h,old_buckets.size());
+				if (old_index>=migrate_pos)
+				{
+					return first_in(old_buckets,old_index+1);
+				}
+			}
+			node* next = first_in(buckets,BucketPolicy::index(h,buckets.size())+1);
+			return next ? next : first_in(old_buckets,migrate_pos);
 		}
 
-		size_type bucket_num_by_val(const value_type& v)const
+		//从旧桶数组迁移最多steps个桶,全部迁完后释放旧数组
+		void migrate_buckets(size_type steps)
 		{
-			return bucket_num_val(v,buckets.size());
+			const size_type old_num = old_buckets.size();
+			for(;steps!=0 && migrate_pos<old_num;--steps,++migrate_pos)
+			{
+				node* first = old_buckets[migrate_pos];
+				while(first)
+				{
+					node* next = first->next;
+					const size_type index = bucket_num_node(first,buckets.size());
+					first->next = buckets[index];
+					buckets[index] = first;
+					first = next;
+				}
+				old_buckets[migrate_pos] = nullptr;
+			}
+			if (migrate_pos==old_num)
+			{
+				bucket_vector().swap(old_buckets);
+				migrate_pos = 0;
+			}
+		}
+		void migrate_step()
+		{
+			if (!old_buckets.empty())
+			{
+				migrate_buckets(rehash_step);
+			}
 		}
 
-		void buckets_copy_from(const vector<node*>& buck)
+		void buckets_copy_from(bucket_vector& dest,const bucket_vector& buck)
 		{
-			buckets.clear();
-			buckets.reserve(buck.size());
-			buckets.insert(buckets.end(),buck.size(),(node*)0);
-			for(auto i = 0;i<buck.size();++i)
+			dest.clear();
+			dest.reserve(buck.size());
+			dest.insert(dest.end(),buck.size(),(node*)0);
+			for(size_type i = 0;i<buck.size();++i)
 			{
 				if(const node* cur = buck[i])
 				{
-					node* copy = new_node(cur->val);
-					buckets[i] = copy;
+					node* copy = new_node(cur->val,cur->get_hash());
+					dest[i] = copy;
 					for(node* next = cur->next;next!=nullptr;cur=next,next=cur->next)
 					{
-						copy->next = new_node(next->val);
+						copy->next = new_node(next->val,next->get_hash());
 						copy = copy->next;
 					}
 				}
 			}
 		}
 
-		void clear()
+		void clear_buckets(bucket_vector& buck)
 		{
-			for(size_type i = 0;i<buckets.size();++i)
+			for(size_type i = 0;i<buck.size();++i)
 			{
-				node* cur = buckets[i];
+				node* cur = buck[i];
 				while(cur!=nullptr)
 				{
 					node* next = cur->next;
 					delete_node(cur);
 					cur = next;
 				}
-				buckets[i] = nullptr;
+				buck[i] = nullptr;
 			}
-			ele_nums = 0;
 		}
 
+		//一次性把全部元素重新分配到n个桶
+		void rebuild(size_type n)
+		{
+			migrate_buckets(old_buckets.size());
+			const size_type old_num = buckets.size();
+			if (n==old_num)
+			{
+				return;
+			}
+			bucket_vector temp(n,(node*)0);
+			for(size_type index=0;index<old_num;++index)
+			{
+				node* first = buckets[index];
+				while(first)
+				{
+					 size_type new_index = bucket_num_node(first,n);
+					 buckets[index] = first->next;
+					 first->next = temp[new_index];
+					 temp[new_index] = first;
+					 first = buckets[index];
+				}
+			}
+			buckets.swap(temp);
+		}
+
+		//元素数将达到num时按需扩容
 		void resize(size_type num)
 		{
 			const size_type old_num = buckets.size();
-			if (num>old_num)
+			if (double(num)>double(old_num)*max_load)
 			{
-				const size_type n = next_prime(num);
-				if (n>old_num)
+				const size_type n = BucketPolicy::bucket_count(min_buckets_for(num));
+				if (n>old_num && incremental)
 				{
-					vector<node*> temp(n,(node*)0);
-					for(size_type index=0;index<old_num;++index)
-					{
-						node* first = buckets[index];
-						while(first)
-						{
-							 size_type new_index = bucket_num_val(first->val,n);
-							 buckets[index] = first->next;
-							 first->next = temp[new_index];
-							 temp[new_index] = first;
-							 first = buckets[index];
-						}
-					}
+					//上一轮迁移未完成时先迁完,再把当前桶数组转为旧数组
+					migrate_buckets(old_buckets.size());
+					bucket_vector temp(n,(node*)0);
+					old_buckets.swap(buckets);
 					buckets.swap(temp);
+					migrate_pos = 0;
+				}
+				else if (n>old_num)
+				{
+					rebuild(n);
 				}
 			}
 		}
 
 		pair<iterator,bool> insert_unique_noresize(const value_type& v)
 		{
-			const size_type index = bucket_num_by_val(v);
-			node* first = buckets[index];
-			for(node* cur = first;cur!=nullptr;cur=cur->next)
+			const size_type h = hash(get_key(v));
+			node*& head = bucket_ref(h);
+			for(node* cur = head;cur!=nullptr;cur=cur->next)
 			{
-				if (equals(get_key(v),get_key(cur->val)))
+				if (node_matches(cur,get_key(v),h))
 				{
 					return pair<iterator,bool>(iterator(cur,this),false);
 				}
 			}
-			node* temp = new_node(v);
-			temp->next = buckets[index];
-			buckets[index] = temp;
+			node* temp = new_node(v,h);
+			temp->next = head;
+			head = temp;
 			++ele_nums;
 			return pair<iterator,bool>(iterator(temp,this),true);
 		}
-	
-	};
 
-	//Iterator ++
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
-	hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>& hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>::operator++()
-	{
-		const node* old = cur;
-		cur = cur->next;
-		if(!cur)
+		//有相等的键时插在第一个相等结点之后,否则插在链首
+		iterator insert_equal_noresize(const value_type& v)
 		{
-			size_type bucket = ht->bucket_num_by_val(old->val);
-			while(!cur && ++bucket<ht->buckets.size())
+			const size_type h = hash(get_key(v));
+			node*& head = bucket_ref(h);
+			node* temp = new_node(v,h);
+			for(node* cur = head;cur!=nullptr;cur=cur->next)
 			{
-				cur = ht->buckets[bucket];
+				if (node_matches(cur,get_key(v),h))
+				{
+					temp->next = cur->next;
+					cur->next = temp;
+					++ele_nums;
+					return iterator(temp,this);
+				}
 			}
+			temp->next = head;
+			head = temp;
+			++ele_nums;
+			return iterator(temp,this);
 		}
+	
+	};
+
+	//Iterator ++
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
+	hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>& hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>::operator++()
+	{
+		cur = ht->next_node(cur);
 		return *this;
 	}
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
-	hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey> hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>::operator++(int)
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
+	hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> hashtable_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>::operator++(int)
 	{
 		iterator temp = *this;
 		++(*this);
 		return temp;
 	}
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
-	hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>& hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>::operator++()
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
+	hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>& hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>::operator++()
 	{
-		const node* old = cur;
-		cur = cur->next;
-		if(!cur)
-		{
-			size_type bucket = ht->bucket_num_by_val(old->val);
-			while(!cur && ++bucket<ht->buckets.size())
-			{
-				cur = ht->buckets[bucket];
-			}
-		}
+		cur = ht->next_node(cur);
 		return *this;
 	}
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
-	hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey> hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey>::operator++(int)
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
+	hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc> hashtable_const_iterator<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>::operator++(int)
 	{
 		iterator temp = *this;
 		++(*this);
 		return temp;
 	}
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
-	bool operator==(const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey>& ht1,
-					const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey>& ht2)
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
+	bool operator==(const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>& ht1,
+					const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>& ht2)
 	{
-		typedef typename hashtable<Value,Key,HashFcn,ExtractKey,EqualKey>::node node;
-		if (ht1.buckets.size()!=ht2.buckets.size()||ht1.size()!=ht2.size())
+		typedef typename hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>::const_iterator const_iterator;
+		if (ht1.size()!=ht2.size())
 		{
 			return false;
 		}
-		for(auto index=0;index<ht1.buckets.size();++index)
+		//相等的键相邻,逐段与另一张表中的equal_range比较,段内元素顺序可以不同;与桶数和迁移进度无关
+		for(const_iterator it = ht1.begin();it!=ht1.end();)
 		{
-			node* cur1 = ht1.buckets[index];
-			node* cur2 = ht2.buckets[index];
-			while(cur1 && cur2 && cur1->val==cur2->val)
+			const pair<const_iterator,const_iterator> r1 = ht1.equal_range(ht1.get_key(*it));
+			const pair<const_iterator,const_iterator> r2 = ht2.equal_range(ht1.get_key(*it));
+			if (MINI_STL::distance(r1.first,r1.second)!=MINI_STL::distance(r2.first,r2.second))
 			{
-				cur1 = cur1->next;
-				cur2 = cur2->next;
+				return false;
 			}
-			if (cur1 || cur2)
+			for(const_iterator i = r1.first;i!=r1.second;++i)
 			{
-				return false;
+				ptrdiff_t n = 0;
+				for(const_iterator j = r1.first;j!=r1.second;++j)
+				{
+					n += (*j==*i);
+				}
+				for(const_iterator j = r2.first;j!=r2.second;++j)
+				{
+					n -= (*j==*i);
+				}
+				if (n!=0)
+				{
+					return false;
+				}
 			}
+			it = r1.second;
 		}
 		return true;
 	}
 
-	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey>
-	bool operator!=(const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey>& ht1,
-					const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey>& ht2)
+	template<class Value,class Key,class HashFcn,class ExtractKey,class EqualKey,class BucketPolicy,bool CacheHash,class Alloc>
+	bool operator!=(const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>& ht1,
+					const hashtable<Value,Key,HashFcn,ExtractKey,EqualKey,BucketPolicy,CacheHash,Alloc>& ht2)
 	{
 		return !(ht1==ht2);
 	}
@@ -1,6 +1,14 @@
 #ifndef _MINI_STL_HASHFCN_H
 #define _MINI_STL_HASHFCN_H
 
+#include "Pair.h"
+#include <cstring>
+#include <random>
+#include <string>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 namespace MINI_STL
 {
     template <class Key> 
@@ -8,12 +16,162 @@ namespace MINI_STL
     {
     };
 
+    //把哈希值的每一位扩散到所有位上(murmur3的fmix),弥补整数恒等哈希的低熵
+    template<size_t Bytes>
+    struct hash_mixer;
+
+    template<>
+    struct hash_mixer<4>
+    {
+        static size_t mix(size_t h)
+        {
+            h ^= h >> 16;
+            h *= 0x85ebca6bu;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35u;
+            h ^= h >> 16;
+            return h;
+        }
+    };
+
+    template<>
+    struct hash_mixer<8>
+    {
+        static size_t mix(size_t h)
+        {
+            unsigned long long x = h;
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdull;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ull;
+            x ^= x >> 33;
+            return size_t(x);
+        }
+    };
+
+    inline size_t hash_mix(size_t h)
+    {
+        return hash_mixer<sizeof(size_t)>::mix(h);
+    }
+
+    //64x64位乘法,a得到乘积的低64位,b得到高64位
+    inline void hash_mum(unsigned long long& a, unsigned long long& b)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = a;
+        r *= b;
+        a = (unsigned long long)r;
+        b = (unsigned long long)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+#else
+        const unsigned long long ha = a >> 32, hb = b >> 32;
+        const unsigned long long la = (unsigned int)a, lb = (unsigned int)b;
+        const unsigned long long rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        const unsigned long long t = rl + (rm0 << 32);
+        unsigned long long c = t < rl;
+        const unsigned long long lo = t + (rm1 << 32);
+        c += lo < t;
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+    }
+
+    inline unsigned long long hash_mum_mix(unsigned long long a, unsigned long long b)
+    {
+        hash_mum(a, b);
+        return a ^ b;
+    }
+
+    //非对齐读取,按小端解释
+    inline unsigned long long hash_read8(const unsigned char* p)
+    {
+        unsigned long long v;
+        memcpy(&v, p, 8);
+        return v;
+    }
+    inline unsigned long long hash_read4(const unsigned char* p)
+    {
+        unsigned int v;
+        memcpy(&v, p, 4);
+        return v;
+    }
+
+    /************************************************************************/
+    /*  hash_bytes:任意字节序列的哈希(wyhash的结构)
+        1.每次读取8字节,两个64位数相乘后折叠高低位;超过48字节时三路并行
+        2.尾部用与前面重叠的整字读取,不逐字节循环
+        3.seed参与初始状态,不同的seed得到互不相关的哈希,可抵御哈希洪水攻击
+    */
+    /************************************************************************/
+    inline size_t hash_bytes(const void* key, size_t len, size_t seed = 0)
+    {
+        static const unsigned long long secret[4] = {
+            0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+            0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+        };
+        const unsigned char* p = static_cast<const unsigned char*>(key);
+        unsigned long long s = seed ^ hash_mum_mix(seed ^ secret[0], secret[1]);
+        unsigned long long a, b;
+        if (len <= 16)
+        {
+            if (len >= 4)
+            {
+                const size_t mid = (len >> 3) << 2;
+                a = (hash_read4(p) << 32) | hash_read4(p + mid);
+                b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - mid);
+            }
+            else if (len > 0)
+            {
+                a = ((unsigned long long)p[0] << 16) | ((unsigned long long)p[len >> 1] << 8) | p[len - 1];
+                b = 0;
+            }
+            else
+            {
+                a = b = 0;
+            }
+        }
+        else
+        {
+            size_t i = len;
+            if (i > 48)
+            {
+                unsigned long long s1 = s, s2 = s;
+                do
+                {
+                    s = hash_mum_mix(hash_read8(p) ^ secret[1], hash_read8(p + 8) ^ s);
+                    s1 = hash_mum_mix(hash_read8(p + 16) ^ secret[2], hash_read8(p + 24) ^ s1);
+                    s2 = hash_mum_mix(hash_read8(p + 32) ^ secret[3], hash_read8(p + 40) ^ s2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                s ^= s1 ^ s2;
+            }
+            while (i > 16)
+            {
+                s = hash_mum_mix(hash_read8(p) ^ secret[1], hash_read8(p + 8) ^ s);
+                p += 16;
+                i -= 16;
+            }
+            a = hash_read8(p + i - 16);
+            b = hash_read8(p + i - 8);
+        }
+        a ^= secret[1];
+        b ^= s;
+        hash_mum(a, b);
+        const unsigned long long h = hash_mum_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+        return sizeof(size_t) >= 8 ? size_t(h) : size_t(h ^ (h >> 32));
+    }
+
     inline size_t hash_string(const char* s)
     {
-        unsigned long h = 0; 
-        for ( ; *s; ++s)
-            h = 5*h + *s;
-        return size_t(h);
+        return hash_bytes(s, strlen(s));
+    }
+
+    //把h并入seed,用于组合多个字段的哈希
+    inline size_t hash_combine(size_t seed, size_t h)
+    {
+        return hash_mix(seed ^ (h + size_t(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2)));
     }
 
     template<>
@@ -64,6 +222,104 @@ namespace MINI_STL
     struct hash<unsigned long> {
         size_t operator()(unsigned long x) const { return x; }
     };
+    //32位平台上把高32位折叠进来
+    template<>
+    struct hash<unsigned long long> {
+        size_t operator()(unsigned long long x) const { return sizeof(size_t) >= 8 ? size_t(x) : size_t(x ^ (x >> 32)); }
+    };
+    template<>
+    struct hash<long long> {
+        size_t operator()(long long x) const { return hash<unsigned long long>()(x); }
+    };
+
+    //指针的低位因对齐总是0,先扩散
+    template<class T>
+    struct hash<T*> {
+        size_t operator()(T* p) const { return hash_mix(reinterpret_cast<size_t>(p)); }
+    };
+
+    //按位模式哈希,+0与-0相等所以都映射为0
+    template<>
+    struct hash<float> {
+        size_t operator()(float x) const
+        {
+            if (x == 0)
+                return 0;
+            unsigned int bits;
+            memcpy(&bits, &x, sizeof(bits));
+            return hash_mix(bits);
+        }
+    };
+    template<>
+    struct hash<double> {
+        size_t operator()(double x) const
+        {
+            if (x == 0)
+                return 0;
+            unsigned long long bits;
+            memcpy(&bits, &x, sizeof(bits));
+            return hash_mix(hash<unsigned long long>()(bits));
+        }
+    };
+    //long double的填充字节不确定,转成double再哈希,相等的值仍得到相同的哈希
+    template<>
+    struct hash<long double> {
+        size_t operator()(long double x) const { return hash<double>()(double(x)); }
+    };
+
+    template<>
+    struct hash<std::string> {
+        size_t operator()(const std::string& s) const { return hash_bytes(s.data(), s.size()); }
+    };
+
+    template<class T1, class T2>
+    struct hash<pair<T1, T2> > {
+        size_t operator()(const pair<T1, T2>& p) const
+        {
+            return hash_combine(hash<T1>()(p.first), hash<T2>()(p.second));
+        }
+    };
+
+    //每次调用取一个随机种子
+    inline size_t hash_random_seed()
+    {
+        std::random_device rd;
+        return size_t((unsigned long long)rd() << 32 ^ rd());
+    }
+
+    /************************************************************************/
+    /*  seeded_hash:带种子的哈希,默认构造时取随机种子
+        1.字符串按种子重新做hash_bytes,攻击者无法离线构造大量碰撞的键
+        2.其他类型在hash<Key>的结果上混入种子
+        3.种子随哈希函数对象一起被容器复制,同一容器内哈希稳定
+    */
+    /************************************************************************/
+    template<class Key>
+    struct seeded_hash
+    {
+        size_t seed;
+        seeded_hash() : seed(hash_random_seed()) {}
+        explicit seeded_hash(size_t s) : seed(s) {}
+        size_t operator()(const Key& k) const { return hash_mix(hash<Key>()(k) ^ seed); }
+    };
+
+    template<>
+    struct seeded_hash<std::string>
+    {
+        size_t seed;
+        seeded_hash() : seed(hash_random_seed()) {}
+        explicit seeded_hash(size_t s) : seed(s) {}
+        size_t operator()(const std::string& s) const { return hash_bytes(s.data(), s.size(), seed); }
+    };
+
+    template<>
+    struct seeded_hash<const char*>
+    {
+        size_t seed;
+        seeded_hash() : seed(hash_random_seed()) {}
+        explicit seeded_hash(size_t s) : seed(s) {}
+        size_t operator()(const char* s) const { return hash_bytes(s, strlen(s), seed); }
+    };
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef _MINI_STL_HASH_MULTISET_H_
+#define _MINI_STL_HASH_MULTISET_H_
+
+#include "Functional.h"
+#include "Hash_fcn.h"
+#include "HashTable.h"
+#include "Pair.h"
+
+namespace MINI_STL
+{
+	//允许重复元素,相等的元素遍历时相邻;BucketPolicy与CacheHash的含义同hashset
+	template<class Value,class HashFcn=hash<Value>,class EqualKey=equal_to<Value>,class BucketPolicy=prime_bucket_policy,bool CacheHash=false>
+	class hash_multiset
+	{
+	private:
+		typedef hashtable<Value,Value,HashFcn,identity<Value>,EqualKey,BucketPolicy,CacheHash> ht;
+		ht htable;
+
+	public:
+		typedef typename ht::key_type key_type;
+		typedef typename ht::value_type value_type;
+		typedef typename ht::hasher hasher;
+		typedef typename ht::key_equal key_equal;
+
+		typedef typename ht::size_type size_type;
+		typedef typename ht::difference_type difference_type;
+		typedef typename ht::const_pointer pointer;
+		typedef typename ht::const_pointer const_pointer;
+		typedef typename ht::const_reference reference;
+		typedef typename ht::const_reference const_reference;
+
+		typedef typename ht::const_iterator iterator;
+		typedef typename ht::const_iterator const_iterator;
+
+		hash_multiset():htable(100,hasher(),key_equal()){}
+		explicit hash_multiset(size_type n):htable(n,hasher(),key_equal()){}
+		template<class InputIterator>
+		hash_multiset(InputIterator first,InputIterator last):htable(100,hasher(),key_equal()){htable.insert_equal(first,last);}
+
+		size_type size()const{return htable.size();}
+		bool empty()const{return htable.empty();}
+
+		iterator begin()const{return htable.begin();}
+		iterator end()const{return htable.end();}
+
+		iterator insert(const value_type& v){return htable.insert_equal(v);}
+		template<class InputIterator>
+		void insert(InputIterator first,InputIterator last){htable.insert_equal(first,last);}
+
+		iterator find(const key_type& k)const{return htable.find(k);}
+		size_type count(const key_type& k)const{return htable.count(k);}
+		pair<iterator,iterator> equal_range(const key_type& k)const{return htable.equal_range(k);}
+
+		size_type erase(const key_type& k){return htable.erase(k);}
+		void erase(iterator position){htable.erase(position);}
+		void erase(iterator first,iterator last){htable.erase(first,last);}
+
+		void set_incremental_rehash(bool on){htable.set_incremental_rehash(on);}
+		bool rehashing()const{return htable.rehashing();}
+
+		size_type bucket_count()const{return htable.bucket_count();}
+		float load_factor()const{return htable.load_factor();}
+		float max_load_factor()const{return htable.max_load_factor();}
+		void max_load_factor(float z){htable.max_load_factor(z);}
+		void rehash(size_type n){htable.rehash(n);}
+		void reserve(size_type n){htable.reserve(n);}
+
+		void clear(){htable.clear();}
+		void swap(hash_multiset& x){htable.swap(x.htable);}
+
+		template<class Val,class HF,class EqK,class BP,bool CH>
+		friend bool operator==(const hash_multiset<Val,HF,EqK,BP,CH>&,const hash_multiset<Val,HF,EqK,BP,CH>&);
+	};
+
+	template<class Val,class HF,class EqK,class BP,bool CH>
+	inline bool operator==(const hash_multiset<Val,HF,EqK,BP,CH>& x,const hash_multiset<Val,HF,EqK,BP,CH>& y)
+	{
+		return x.htable==y.htable;
+	}
+
+	template<class Val,class HF,class EqK,class BP,bool CH>
+	inline bool operator!=(const hash_multiset<Val,HF,EqK,BP,CH>& x,const hash_multiset<Val,HF,EqK,BP,CH>& y)
+	{
+		return !(x==y);
+	}
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef _MINI_STL_HASHMAP_H_
+#define _MINI_STL_HASHMAP_H_
+
+#include "Functional.h"
+#include "Hash_fcn.h"
+#include "HashTable.h"
+#include "Pair.h"
+
+namespace MINI_STL
+{
+	//键唯一,元素为pair<const Key,T>;BucketPolicy与CacheHash的含义同hashset
+	template<class Key,class T,class HashFcn=hash<Key>,class EqualKey=equal_to<Key>,class BucketPolicy=prime_bucket_policy,bool CacheHash=false>
+	class hashmap
+	{
+	public:
+		typedef Key					key_type;
+		typedef T					data_type;
+		typedef T					mapped_type;
+		typedef pair<const Key,T>	value_type;
+
+	private:
+		typedef hashtable<value_type,Key,HashFcn,selectFirst<value_type>,EqualKey,BucketPolicy,CacheHash> ht;
+		ht htable;
+
+	public:
+		typedef typename ht::hasher hasher;
+		typedef typename ht::key_equal key_equal;
+
+		typedef typename ht::size_type size_type;
+		typedef typename ht::difference_type difference_type;
+		typedef typename ht::pointer pointer;
+		typedef typename ht::const_pointer const_pointer;
+		typedef typename ht::reference reference;
+		typedef typename ht::const_reference const_reference;
+
+		typedef typename ht::iterator iterator;
+		typedef typename ht::const_iterator const_iterator;
+
+		hashmap():htable(100,hasher(),key_equal()){}
+		explicit hashmap(size_type n):htable(n,hasher(),key_equal()){}
+		template<class InputIterator>
+		hashmap(InputIterator first,InputIterator last):htable(100,hasher(),key_equal()){htable.insert_unique(first,last);}
+
+		size_type size()const{return htable.size();}
+		bool empty()const{return htable.empty();}
+
+		iterator begin(){return htable.begin();}
+		iterator end(){return htable.end();}
+		const_iterator begin()const{return htable.begin();}
+		const_iterator end()const{return htable.end();}
+
+		//命中时不构造临时的value_type
+		T& operator[](const key_type& k)
+		{
+			iterator it = htable.find(k);
+			if (it!=htable.end())
+			{
+				return (*it).second;
+			}
+			return (*(htable.insert_unique(value_type(k,T())).first)).second;
+		}
+
+		pair<iterator,bool> insert(const value_type& v){return htable.insert_unique(v);}
+		template<class InputIterator>
+		void insert(InputIterator first,InputIterator last){htable.insert_unique(first,last);}
+
+		iterator find(const key_type& k){return htable.find(k);}
+		const_iterator find(const key_type& k)const{return htable.find(k);}
+		size_type count(const key_type& k)const{return htable.count(k);}
+		pair<iterator,iterator> equal_range(const key_type& k){return htable.equal_range(k);}
+		pair<const_iterator,const_iterator> equal_range(const key_type& k)const{return htable.equal_range(k);}
+
+		size_type erase(const key_type& k){return htable.erase(k);}
+		void erase(iterator position){htable.erase(position);}
+		void erase(iterator first,iterator last){htable.erase(first,last);}
+
+		void set_incremental_rehash(bool on){htable.set_incremental_rehash(on);}
+		bool rehashing()const{return htable.rehashing();}
+
+		size_type bucket_count()const{return htable.bucket_count();}
+		float load_factor()const{return htable.load_factor();}
+		float max_load_factor()const{return htable.max_load_factor();}
+		void max_load_factor(float z){htable.max_load_factor(z);}
+		void rehash(size_type n){htable.rehash(n);}
+		void reserve(size_type n){htable.reserve(n);}
+
+		void clear(){htable.clear();}
+		void swap(hashmap& x){htable.swap(x.htable);}
+
+		template<class K,class V,class HF,class EqK,class BP,bool CH>
+		friend bool operator==(const hashmap<K,V,HF,EqK,BP,CH>&,const hashmap<K,V,HF,EqK,BP,CH>&);
+	};
+
+	template<class K,class V,class HF,class EqK,class BP,bool CH>
+	inline bool operator==(const hashmap<K,V,HF,EqK,BP,CH>& x,const hashmap<K,V,HF,EqK,BP,CH>& y)
+	{
+		return x.htable==y.htable;
+	}
+
+	template<class K,class V,class HF,class EqK,class BP,bool CH>
+	inline bool operator!=(const hashmap<K,V,HF,EqK,BP,CH>& x,const hashmap<K,V,HF,EqK,BP,CH>& y)
+	{
+		return !(x==y);
+	}
+}
+
+#endif
@@ -7,16 +7,17 @@
 #include "Functional.h"
 namespace MINI_STL
 {
-	template<class Value,class HashFcn=hash<Value>,class EqualKey=equal_to<Value>>
+	//BucketPolicy为prime_bucket_policy或pow2_bucket_policy;CacheHash为true时结点保存哈希值,适合字符串等键
+	template<class Value,class HashFcn=hash<Value>,class EqualKey=equal_to<Value>,class BucketPolicy=prime_bucket_policy,bool CacheHash=false>
 	class hashset;
-	template <class Val, class HF, class EqK>  
-  	inline bool operator== (const hashset<Val, HF, EqK>& hs1,const hashset<Val, HF, EqK>& hs2);
+	template <class Val, class HF, class EqK, class BP, bool CH>  
+  	inline bool operator== (const hashset<Val, HF, EqK, BP, CH>& hs1,const hashset<Val, HF, EqK, BP, CH>& hs2);
   	
-	template<class Value,class HashFcn,class EqualKey>
+	template<class Value,class HashFcn,class EqualKey,class BucketPolicy,bool CacheHash>
 	class hashset
 	{
     private:
-    	typedef hashtable<Value,Value,HashFcn,identity<Value>,EqualKey> ht;
+    	typedef hashtable<Value,Value,HashFcn,identity<Value>,EqualKey,BucketPolicy,CacheHash> ht;
     	ht htable;
 
     public:
@@ -34,11 +35,13 @@ namespace MINI_STL
 
     	typedef typename ht::const_iterator iterator;
     	typedef typename ht::const_iterator const_iterator;
-    	template <class Val, class HF, class EqK>  
-  		friend bool operator== (const hashset<Val, HF, EqK>&,
-                          		const hashset<Val, HF, EqK>&);
+    	template <class Val, class HF, class EqK, class BP, bool CH>  
+  		friend bool operator== (const hashset<Val, HF, EqK, BP, CH>&,
+                          		const hashset<Val, HF, EqK, BP, CH>&);
 
     	hashset():htable(100,hasher(),key_equal()){}
+		//预计存放n个元素,一次分配好桶数组
+		explicit hashset(size_type n):htable(n,hasher(),key_equal()){}
 
     	size_type size()const {return htable.size();}
     	bool empty()const {return htable.empty();}
@@ -67,20 +70,35 @@ namespace MINI_STL
     	{
     		return htable.erase(k);
     	}
+		void erase(iterator position){htable.erase(position);}
+		void erase(iterator first,iterator last){htable.erase(first,last);}
+		size_type count(const key_type& k)const{return htable.count(k);}
 
 		bool isContain(const key_type& k)const
 		{
 			return find(k)!=end();
 		}
 
+		//开启后扩容时旧桶分摊到之后的插入中迁移,避免一次性重建的停顿
+		void set_incremental_rehash(bool on){htable.set_incremental_rehash(on);}
+		bool rehashing()const{return htable.rehashing();}
+
+		size_type bucket_count()const{return htable.bucket_count();}
+		float load_factor()const{return htable.load_factor();}
+		float max_load_factor()const{return htable.max_load_factor();}
+		void max_load_factor(float z){htable.max_load_factor(z);}
+		void rehash(size_type n){htable.rehash(n);}
+		void reserve(size_type n){htable.reserve(n);}
+
     	void clear()
     	{
     		htable.clear();
     	}
+		void swap(hashset& x){htable.swap(x.htable);}
 	};
 
-	template <class Val, class HF, class EqK>  
-  	inline bool operator== (const hashset<Val, HF, EqK>& hs1,const hashset<Val, HF, EqK>& hs2)
+	template <class Val, class HF, class EqK, class BP, bool CH>  
+  	inline bool operator== (const hashset<Val, HF, EqK, BP, CH>& hs1,const hashset<Val, HF, EqK, BP, CH>& hs2)
   	{
   		return hs1.htable==hs2.htable;
   	}
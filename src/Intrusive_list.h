@@ -0,0 +1,181 @@
+#ifndef _MINI_STL_INTRUSIVE_LIST_H_
+#define _MINI_STL_INTRUSIVE_LIST_H_
+
+#include "Algorithm.h"
+#include "Iterator.h"
+
+namespace MINI_STL
+{
+	//成员member在T中的字节偏移
+	template<class T,class Member>
+	inline size_t member_offset(Member T::* member)
+	{
+		//用非空地址计算,避免对空指针解引用
+		T* p = reinterpret_cast<T*>(16);
+		return reinterpret_cast<char*>(&(p->*member))-reinterpret_cast<char*>(p);
+	}
+
+	//由成员member的地址得到所在的T对象
+	template<class T,class Member>
+	inline T* owner_of(Member* m,Member T::* member)
+	{
+		return reinterpret_cast<T*>(reinterpret_cast<char*>(m)-member_offset(member));
+	}
+
+	/************************************************************************/
+	/*	intrusive_list:侵入式双向循环链表
+		1.链接指针(intrusive_list_hook)是元素自身的成员,容器不分配结点也不拷贝元素
+		2.元素的生存期由使用者管理,元素在链表中时不能销毁;一个元素有几个hook就能同时挂在几个链表中
+		3.header是容器自身的成员,因此容器不可拷贝,swap时需要修正首尾结点的指针
+	*/
+	/************************************************************************/
+	struct intrusive_list_hook
+	{
+		intrusive_list_hook* prev;
+		intrusive_list_hook* next;
+
+		intrusive_list_hook():prev(0),next(0){}
+		bool is_linked()const{return next!=0;}
+	};
+
+	template<class T,intrusive_list_hook T::* Hook>
+	struct intrusive_list_iterator
+	{
+		typedef bidirectional_iterator_tag	iterator_category;
+		typedef T							value_type;
+		typedef T*							pointer;
+		typedef T&							reference;
+		typedef ptrdiff_t					difference_type;
+
+		intrusive_list_hook* node;
+
+		intrusive_list_iterator():node(0){}
+		explicit intrusive_list_iterator(intrusive_list_hook* x):node(x){}
+
+		reference operator*()const{return *owner_of(node,Hook);}
+		pointer operator->()const{return owner_of(node,Hook);}
+
+		intrusive_list_iterator& operator++(){node = node->next;return *this;}
+		intrusive_list_iterator operator++(int){auto temp = *this;node = node->next;return temp;}
+		intrusive_list_iterator& operator--(){node = node->prev;return *this;}
+		intrusive_list_iterator operator--(int){auto temp = *this;node = node->prev;return temp;}
+
+		bool operator==(const intrusive_list_iterator& x)const{return node==x.node;}
+		bool operator!=(const intrusive_list_iterator& x)const{return node!=x.node;}
+	};
+
+	template<class T,intrusive_list_hook T::* Hook>
+	class intrusive_list
+	{
+	public:
+		typedef T										value_type;
+		typedef T*										pointer;
+		typedef T&										reference;
+		typedef size_t									size_type;
+		typedef ptrdiff_t								difference_type;
+		typedef intrusive_list_iterator<T,Hook>			iterator;
+
+	private:
+		intrusive_list_hook header;
+		size_type ele_nums;
+
+		intrusive_list(const intrusive_list&);
+		intrusive_list& operator=(const intrusive_list&);
+
+		static intrusive_list_hook* hook_of(T& x){return &(x.*Hook);}
+
+		void reset()
+		{
+			header.prev = &header;
+			header.next = &header;
+			ele_nums = 0;
+		}
+
+		//把[first,last]链到position之前
+		static void link_range(intrusive_list_hook* position,intrusive_list_hook* first,intrusive_list_hook* last)
+		{
+			first->prev = position->prev;
+			last->next = position;
+			position->prev->next = first;
+			position->prev = last;
+		}
+
+	public:
+		intrusive_list(){reset();}
+		//只解除链接,不销毁元素
+		~intrusive_list(){clear();}
+
+		iterator begin(){return iterator(header.next);}
+		iterator end(){return iterator(&header);}
+		//元素x在链表中的位置,O(1)
+		static iterator iterator_to(T& x){return iterator(hook_of(x));}
+
+		size_type size()const{return ele_nums;}
+		bool empty()const{return ele_nums==0;}
+
+		reference front(){return *begin();}
+		reference back(){return *iterator(header.prev);}
+
+		//把x链到position之前,x不能已在某个链表中
+		iterator insert(iterator position,T& x)
+		{
+			intrusive_list_hook* node = hook_of(x);
+			link_range(position.node,node,node);
+			++ele_nums;
+			return iterator(node);
+		}
+
+		//解除position的链接,返回下一个位置
+		iterator erase(iterator position)
+		{
+			intrusive_list_hook* node = position.node;
+			intrusive_list_hook* next = node->next;
+			node->prev->next = next;
+			next->prev = node->prev;
+			node->prev = 0;
+			node->next = 0;
+			--ele_nums;
+			return iterator(next);
+		}
+
+		void push_back(T& x){insert(end(),x);}
+		void push_front(T& x){insert(begin(),x);}
+		void pop_back(){erase(iterator(header.prev));}
+		void pop_front(){erase(begin());}
+		void remove(T& x){erase(iterator_to(x));}
+
+		void clear()
+		{
+			for (intrusive_list_hook* cur = header.next; cur != &header; )
+			{
+				intrusive_list_hook* next = cur->next;
+				cur->prev = 0;
+				cur->next = 0;
+				cur = next;
+			}
+			reset();
+		}
+
+		//把x的全部元素移到position之前
+		void splice(iterator position,intrusive_list& x)
+		{
+			if (this==&x || x.empty())
+			{
+				return;
+			}
+			link_range(position.node,x.header.next,x.header.prev);
+			ele_nums += x.ele_nums;
+			x.reset();
+		}
+
+		void swap(intrusive_list& x)
+		{
+			intrusive_list temp;
+			temp.splice(temp.end(),*this);
+			splice(end(),x);
+			x.splice(x.end(),temp);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef _MINI_STL_INTRUSIVE_RBTREE_H_
+#define _MINI_STL_INTRUSIVE_RBTREE_H_
+
+#include "Functional.h"
+#include "Intrusive_list.h"
+#include "Pair.h"
+#include "RBTree.h"
+
+namespace MINI_STL
+{
+	/************************************************************************/
+	/*	intrusive_rbtree:侵入式红黑树
+		1.结点就是元素中的RBTree_node_base成员,插入/删除只修改指针,不分配不拷贝
+		2.平衡调整直接复用RBTree的rebalance/rebalance_for_erase,迭代器复用RBTree_iterator_base
+		3.Compare比较的是元素本身;元素在树中时不能修改参与比较的字段
+		4.header是容器自身的成员,因此容器不可拷贝
+	*/
+	/************************************************************************/
+	typedef RBTree_node_base intrusive_rbtree_hook;
+
+	template<class T,intrusive_rbtree_hook T::* Hook>
+	struct intrusive_rbtree_iterator : public RBTree_iterator_base
+	{
+		typedef T	value_type;
+		typedef T*	pointer;
+		typedef T&	reference;
+
+		intrusive_rbtree_iterator(){node = 0;}
+		explicit intrusive_rbtree_iterator(base_ptr x){node = x;}
+
+		reference operator*()const{return *owner_of(node,Hook);}
+		pointer operator->()const{return owner_of(node,Hook);}
+
+		intrusive_rbtree_iterator& operator++(){increment();return *this;}
+		intrusive_rbtree_iterator operator++(int){auto temp = *this;increment();return temp;}
+		intrusive_rbtree_iterator& operator--(){decrement();return *this;}
+		intrusive_rbtree_iterator operator--(int){auto temp = *this;decrement();return temp;}
+	};
+
+	template<class T,intrusive_rbtree_hook T::* Hook,class Compare=less<T>>
+	class intrusive_rbtree
+	{
+	public:
+		typedef T									value_type;
+		typedef T*									pointer;
+		typedef T&									reference;
+		typedef size_t								size_type;
+		typedef ptrdiff_t							difference_type;
+		typedef intrusive_rbtree_iterator<T,Hook>	iterator;
+
+	private:
+		typedef RBTree_node_base* base_ptr;
+
+		intrusive_rbtree_hook header;
+		size_type node_count;
+		Compare comp;
+
+		intrusive_rbtree(const intrusive_rbtree&);
+		intrusive_rbtree& operator=(const intrusive_rbtree&);
+
+		static base_ptr hook_of(T& x){return &(x.*Hook);}
+		static T& value(base_ptr x){return *owner_of(x,Hook);}
+
+		void reset()
+		{
+			header.color = red;
+			header.parent = 0;
+			header.left = &header;
+			header.right = &header;
+			node_count = 0;
+		}
+
+		//后序清空x子树中各结点的指针
+		static void unlink_recursive(base_ptr x)
+		{
+			while (x!=0)
+			{
+				unlink_recursive(x->right);
+				base_ptr y = x->left;
+				x->parent = 0;
+				x->left = 0;
+				x->right = 0;
+				x = y;
+			}
+		}
+
+		//把z作为par的左/右子结点链入并调整平衡
+		iterator link(base_ptr z,base_ptr par,bool left_side)
+		{
+			if (par==&header)
+			{
+				header.parent = z;
+				header.left = z;
+				header.right = z;
+			}
+			else if (left_side)
+			{
+				par->left = z;
+				if (par==header.left)
+				{
+					header.left = z;
+				}
+			}
+			else
+			{
+				par->right = z;
+				if (par==header.right)
+				{
+					header.right = z;
+				}
+			}
+			z->parent = par;
+			z->left = 0;
+			z->right = 0;
+			rebalance(z,header.parent);
+			++node_count;
+			return iterator(z);
+		}
+
+	public:
+		intrusive_rbtree(const Compare& c=Compare()):comp(c){reset();}
+		//只解除链接,不销毁元素
+		~intrusive_rbtree(){clear();}
+
+		iterator begin(){return iterator(header.left);}
+		iterator end(){return iterator(&header);}
+		static iterator iterator_to(T& x){return iterator(hook_of(x));}
+
+		size_type size()const{return node_count;}
+		bool empty()const{return node_count==0;}
+
+		iterator insert_equal(T& x)
+		{
+			base_ptr y = &header;
+			base_ptr cur = header.parent;
+			bool left_side = true;
+			while (cur!=0)
+			{
+				y = cur;
+				left_side = comp(x,value(cur));
+				cur = left_side ? cur->left : cur->right;
+			}
+			return link(hook_of(x),y,left_side);
+		}
+
+		//已有相等的元素时不插入,返回该元素的位置
+		pair<iterator,bool> insert_unique(T& x)
+		{
+			base_ptr y = &header;
+			base_ptr cur = header.parent;
+			bool left_side = true;
+			while (cur!=0)
+			{
+				y = cur;
+				left_side = comp(x,value(cur));
+				cur = left_side ? cur->left : cur->right;
+			}
+			iterator j(y);
+			if (left_side)
+			{
+				if (j==begin())
+				{
+					return pair<iterator,bool>(link(hook_of(x),y,true),true);
+				}
+				--j;
+			}
+			if (comp(*j,x))
+			{
+				return pair<iterator,bool>(link(hook_of(x),y,left_side),true);
+			}
+			return pair<iterator,bool>(j,false);
+		}
+
+		//解除position的链接
+		void erase(iterator position)
+		{
+			base_ptr z = rebalance_for_erase(position.node,header.parent,header.left,header.right);
+			z->parent = 0;
+			z->left = 0;
+			z->right = 0;
+			--node_count;
+		}
+		void remove(T& x){erase(iterator_to(x));}
+
+		//第一个不小于k的元素,k可以是能与T比较的任意类型
+		template<class Key>
+		iterator lower_bound(const Key& k)
+		{
+			base_ptr y = &header;
+			for (base_ptr cur = header.parent; cur != 0; )
+			{
+				if (!comp(value(cur),k))
+				{
+					y = cur;
+					cur = cur->left;
+				}
+				else
+				{
+					cur = cur->right;
+				}
+			}
+			return iterator(y);
+		}
+
+		template<class Key>
+		iterator upper_bound(const Key& k)
+		{
+			base_ptr y = &header;
+			for (base_ptr cur = header.parent; cur != 0; )
+			{
+				if (comp(k,value(cur)))
+				{
+					y = cur;
+					cur = cur->left;
+				}
+				else
+				{
+					cur = cur->right;
+				}
+			}
+			return iterator(y);
+		}
+
+		template<class Key>
+		iterator find(const Key& k)
+		{
+			iterator j = lower_bound(k);
+			return (j==end() || comp(k,*j)) ? end() : j;
+		}
+
+		//只把各元素的hook清空,O(n)
+		void clear()
+		{
+			unlink_recursive(header.parent);
+			reset();
+		}
+	};
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define _MINI_STL_ITERATOR_TRAITS
 
 #include <stddef.h>
+#include "TypeTraits.h"
 namespace MINI_STL
 {
 	//5类基本迭代器类别
@@ -182,6 +183,19 @@ namespace MINI_STL
 	{
 		_advance(i,n,iterator_category(i));
 	}
+
+	/************************************************************************/
+	/*	分段迭代器萃取:由若干连续内存块组成的序列(如deque)
+		1.segment(it)取it所在的块,local(it)取块内指针
+		2.begin(s)/end(s)为块s的连续区间,compose(s,p)由块和块内指针还原迭代器
+		3.算法据此逐块处理,块内走原生指针的快速版本
+	*/
+	/************************************************************************/
+	template<class Iterator>
+	struct segmented_iterator_traits
+	{
+		typedef _false_type is_segmented_iterator;
+	};
 }
 
 #endif
\ No newline at end of file
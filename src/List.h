@@ -8,9 +8,22 @@
 #include "TypeTraits.h"
 #include "Algorithm.h"
 #include "Functional.h"
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#include <xmmintrin.h>
+#endif
 
 namespace MINI_STL
 {
+	//预取p所在的缓存行,p可以为空
+	inline void list_prefetch(const void* p)
+	{
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+		_mm_prefetch(static_cast<const char*>(p),_MM_HINT_T0);
+#elif defined(__GNUC__)
+		__builtin_prefetch(p);
+#endif
+	}
+
 	template <class T>
 	struct list_node
 	{
@@ -44,6 +57,61 @@ namespace MINI_STL
 		bool operator !=(const list_iterator<T>& it)const{return node!=it.node;}
 	};
 
+	/************************************************************************/
+	/*	list_node_handle:从list中摘下的结点
+		1.持有一个已构造好元素、未链入任何链表的结点,析构时销毁元素并释放结点
+		2.只能移动不能拷贝,用list::insert(position,handle)重新链入,不需要重新分配和拷贝元素
+	*/
+	/************************************************************************/
+	template<class T>
+	class list_node_handle
+	{
+		template<class U>
+		friend class list;
+	public:
+		typedef T value_type;
+
+		list_node_handle():node(nullptr){}
+		list_node_handle(list_node_handle&& x):node(x.node){x.node = nullptr;}
+		list_node_handle& operator=(list_node_handle&& x)
+		{
+			if (this!=&x)
+			{
+				reset();
+				node = x.node;
+				x.node = nullptr;
+			}
+			return *this;
+		}
+		~list_node_handle(){reset();}
+
+		bool empty()const{return node==nullptr;}
+		T& value()const{return node->data;}
+
+	private:
+		list_node<T>* node;
+
+		explicit list_node_handle(list_node<T>* x):node(x){}
+		list_node_handle(const list_node_handle&);
+		list_node_handle& operator=(const list_node_handle&);
+
+		list_node<T>* release()
+		{
+			list_node<T>* temp = node;
+			node = nullptr;
+			return temp;
+		}
+		void reset()
+		{
+			if (node)
+			{
+				destroy(&node->data);
+				Allocator<list_node<T>>::deallocate(node);
+				node = nullptr;
+			}
+		}
+	};
+
 	template<class T>
 	class list
 	{
@@ -58,10 +126,15 @@ namespace MINI_STL
 		typedef reverse_iterator_t<const iterator> const_reverse_iterator;
 		typedef T& reference;
 		typedef size_t size_type;
+		typedef list_node_handle<T> node_type;
 
 	protected:
 		//member
 		listNode *node;
+		//释放的结点先放入空闲链表(用next串起来),create_node优先复用,默认不缓存
+		listNode *free_nodes;
+		size_type free_count;
+		size_type cache_limit;
 		void empty_initialize();
 	public:
 
@@ -95,6 +168,15 @@ namespace MINI_STL
 		listNode* create_node(const T& x);
 		void destroy_node(listNode *node);
 
+		//最多缓存n个已释放的结点,n为0时关闭缓存
+		void set_node_cache_limit(size_type n);
+		size_type node_cache_limit()const{return cache_limit;}
+		size_type cached_nodes()const{return free_count;}
+
+		//摘下/链入结点,不释放也不分配
+		node_type extract(iterator position);
+		iterator insert(iterator position,node_type&& nh);
+
 		//插入、删除
 		iterator insert(iterator position,const T &x);
 		void insert(iterator position,int n,const T& x);
@@ -128,6 +210,17 @@ namespace MINI_STL
 		template<class Compare>
 		void sort(Compare comp);
 
+	protected:
+		//结点数不少于该值且不是基本有序时,sort先把结点指针收集到数组中排序再重新链接
+		enum { sort_array_threshold = 1<<16 };
+		//sort过程中结点只用next串成以NULL结尾的单链,最后再恢复prev
+		template<class Compare>
+		static listNode* merge_chains(listNode* a,listNode* b,Compare comp);
+		template<class Compare>
+		static listNode** sort_node_array(listNode** first,listNode** buf,size_type n,Compare comp);
+		void relink(listNode* chain);
+	public:
+
 		//判断==，!=
 		bool operator==(const list& x);
 		bool operator!=(const list& x);
@@ -141,6 +234,9 @@ namespace MINI_STL
 	template<class T>
 	void list<T>::empty_initialize()
 	{
+		free_nodes = nullptr;
+		free_count = 0;
+		cache_limit = 0;
 		node = acquire_node_space();
 		node->next = node;
 		node->prev = node;
@@ -208,13 +304,24 @@ namespace MINI_STL
 	list<T>::~list()
 	{
 		clear();
+		set_node_cache_limit(0);
 		release_node_space(node);
 	}
 
 	template<class T>
 	typename list<T>::listNode* list<T>::create_node(const T& x)
 	{
-		listNode* node = acquire_node_space();
+		listNode* node;
+		if (free_nodes)
+		{
+			node = free_nodes;
+			free_nodes = free_nodes->next;
+			--free_count;
+		}
+		else
+		{
+			node = acquire_node_space();
+		}
 		construct(&node->data,x);
 		return node;
 	}
@@ -223,7 +330,53 @@ namespace MINI_STL
 	void list<T>::destroy_node(listNode *node)
 	{
 		destroy(&node->data);
-		release_node_space(node);
+		if (free_count<cache_limit)
+		{
+			node->next = free_nodes;
+			free_nodes = node;
+			++free_count;
+		}
+		else
+		{
+			release_node_space(node);
+		}
+	}
+
+	template<class T>
+	void list<T>::set_node_cache_limit(size_type n)
+	{
+		cache_limit = n;
+		while (free_count>n)
+		{
+			listNode* temp = free_nodes;
+			free_nodes = free_nodes->next;
+			--free_count;
+			release_node_space(temp);
+		}
+	}
+
+	template<class T>
+	typename list<T>::node_type list<T>::extract(iterator position)
+	{
+		listNode* x = position.node;
+		x->prev->next = x->next;
+		x->next->prev = x->prev;
+		return node_type(x);
+	}
+
+	template<class T>
+	typename list<T>::iterator list<T>::insert(iterator position,node_type&& nh)
+	{
+		if (nh.empty())
+		{
+			return position;
+		}
+		listNode *temp = nh.release();
+		temp->next = position.node;
+		temp->prev = position.node->prev;
+		position.node->prev->next = temp;
+		position.node->prev = temp;
+		return temp;
 	}
 
 	template<class T>
@@ -453,6 +606,101 @@ namespace MINI_STL
 		sort(less<T>());
 	}
 
+	template<class T>
+	template<class Compare>
+	typename list<T>::listNode* list<T>::merge_chains(listNode* a,listNode* b,Compare comp)
+	{
+		listNode* result;
+		listNode** link = &result;
+		while (a && b)
+		{
+			//相等时取a,保证稳定;同时预取下一个将要比较的结点
+			if (comp(b->data,a->data))
+			{
+				*link = b;
+				link = &b->next;
+				b = b->next;
+				if (b)
+				{
+					list_prefetch(b->next);
+				}
+			}
+			else
+			{
+				*link = a;
+				link = &a->next;
+				a = a->next;
+				if (a)
+				{
+					list_prefetch(a->next);
+				}
+			}
+		}
+		*link = a ? a : b;
+		return result;
+	}
+
+	template<class T>
+	template<class Compare>
+	typename list<T>::listNode** list<T>::sort_node_array(listNode** first,listNode** buf,size_type n,Compare comp)
+	{
+		//先对每32个指针做插入排序,再自底向上两两归并,在first与buf之间来回拷贝
+		const size_type run = 32;
+		for (size_type lo = 0; lo < n; lo += run)
+		{
+			const size_type hi = min(lo+run,n);
+			for (size_type i = lo+1; i < hi; ++i)
+			{
+				listNode* x = first[i];
+				size_type j = i;
+				for (; j > lo && comp(x->data,first[j-1]->data); --j)
+				{
+					first[j] = first[j-1];
+				}
+				first[j] = x;
+			}
+		}
+		listNode** from = first;
+		listNode** to = buf;
+		for (size_type width = run; width < n; width *= 2)
+		{
+			for (size_type lo = 0; lo < n; lo += 2*width)
+			{
+				const size_type mid = min(lo+width,n);
+				const size_type hi = min(lo+2*width,n);
+				size_type i = lo, j = mid, k = lo;
+				while (i<mid && j<hi)
+				{
+					to[k++] = comp(from[j]->data,from[i]->data) ? from[j++] : from[i++];
+				}
+				while (i<mid)
+				{
+					to[k++] = from[i++];
+				}
+				while (j<hi)
+				{
+					to[k++] = from[j++];
+				}
+			}
+			MINI_STL::swap(from,to);
+		}
+		return from;
+	}
+
+	template<class T>
+	void list<T>::relink(listNode* chain)
+	{
+		listNode* prev = node;
+		for (; chain != 0; chain = chain->next)
+		{
+			prev->next = chain;
+			chain->prev = prev;
+			prev = chain;
+		}
+		prev->next = node;
+		node->prev = prev;
+	}
+
 	template<class T>
 	template<class Compare>
 	void list<T>::sort(Compare comp)
@@ -461,29 +709,90 @@ namespace MINI_STL
 		{
 			return;
 		}
-		list carry;
-		list counter[64];
+		//统计结点数与逆序相邻对的个数,基本有序时自然归并更快
+		size_type n = 1;
+		size_type descents = 0;
+		for (listNode* cur = node->next; cur->next != node; cur = cur->next)
+		{
+			++n;
+			if (comp(cur->next->data,cur->data))
+			{
+				++descents;
+			}
+		}
+		node->prev->next = 0;
+
+		if (n>=sort_array_threshold && descents>n/32)
+		{
+			typedef Allocator<listNode*> pointerAllocator;
+			listNode** arr = pointerAllocator::allocate(2*n);
+			listNode* cur = node->next;
+			for (size_type i = 0; i != n; ++i, cur = cur->next)
+			{
+				arr[i] = cur;
+			}
+			listNode** sorted = sort_node_array(arr,arr+n,n,comp);
+			for (size_type i = 0; i+1 < n; ++i)
+			{
+				sorted[i]->next = sorted[i+1];
+			}
+			sorted[n-1]->next = 0;
+			relink(sorted[0]);
+			pointerAllocator::deallocate(arr,2*n);
+			return;
+		}
+
+		//自然归并:依次取出有序段(严格递减段就地翻转),counter[i]存放由2^i个有序段归并而成的链
+		listNode* counter[64];
 		int fill = 0;
-		while(!empty())
+		listNode* cur = node->next;
+		while (cur)
 		{
-			carry.splice(carry.begin(),*this,begin());
-			int i=0;
-			while(i<fill&&!counter[i].empty())
+			listNode* run = cur;
+			cur = cur->next;
+			run->next = 0;
+			if (cur && comp(cur->data,run->data))
 			{
-				counter[i].merge(carry,comp);
-				carry.swap(counter[i++]);
+				while (cur && comp(cur->data,run->data))
+				{
+					listNode* next = cur->next;
+					cur->next = run;
+					run = cur;
+					cur = next;
+				}
 			}
-			carry.swap(counter[i]);
+			else
+			{
+				listNode* last = run;
+				while (cur && !comp(cur->data,last->data))
+				{
+					last->next = cur;
+					last = cur;
+					cur = cur->next;
+				}
+				last->next = 0;
+			}
+			int i = 0;
+			while (i<fill && counter[i])
+			{
+				run = merge_chains(counter[i],run,comp);
+				counter[i++] = 0;
+			}
+			counter[i] = run;
 			if (i==fill)
 			{
 				++fill;
 			}
 		}
-		for (int i = 1; i < fill; ++i)
+		listNode* result = 0;
+		for (int i = 0; i < fill; ++i)
 		{
-			counter[i].merge(counter[i-1],comp);
+			if (counter[i])
+			{
+				result = result ? merge_chains(counter[i],result,comp) : counter[i];
+			}
 		}
-		swap(counter[fill-1]);
+		relink(result);
 	}
 
 	template<class T>
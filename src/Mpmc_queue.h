@@ -0,0 +1,166 @@
+#ifndef _MINI_STL_MPMC_QUEUE_H_
+#define _MINI_STL_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <new>
+#include <thread>
+#include "Algorithm.h"
+#include "Construct.h"
+#include "Spsc_queue.h"
+
+namespace MINI_STL
+{
+	/************************************************************************/
+	/*	mpmc_queue:多生产者多消费者的有界无锁队列(Vyukov)
+		1.每个槽位带一个序号:序号==pos表示可写,序号==pos+1表示可读
+		2.生产者/消费者用CAS推进enqueue_pos/dequeue_pos抢占槽位,
+		  抢到后再写入/取出数据并发布新的序号
+		3.批量操作先数出连续可用的槽位,再一次CAS全部占下
+	*/
+	/************************************************************************/
+	template<class T>
+	class mpmc_queue
+	{
+	public:
+		typedef T			value_type;
+		typedef T&			reference;
+		typedef const T&	const_reference;
+		typedef size_t		size_type;
+
+	private:
+		typedef std::atomic<size_type> sequence_type;
+
+		T* buffer;
+		sequence_type* sequences;
+		size_type mask;
+		char pad0[cache_line_size];
+
+		std::atomic<size_type> enqueue_pos;
+		char pad1[cache_line_size];
+
+		std::atomic<size_type> dequeue_pos;
+		char pad2[cache_line_size];
+
+		mpmc_queue(const mpmc_queue&);
+		mpmc_queue& operator=(const mpmc_queue&);
+
+		//从pos开始最多n个连续槽位中,序号等于pos+i+offset的个数
+		size_type count_slots(size_type pos,size_type n,size_type offset)const
+		{
+			size_type i = 0;
+			while (i<n && sequences[(pos+i)&mask].load(std::memory_order_acquire)==pos+i+offset)
+				++i;
+			return i;
+		}
+
+		//在pos_ref上抢占最多n个序号为pos+i+offset的槽位,返回起点与个数
+		size_type claim(std::atomic<size_type>& pos_ref,size_type n,size_type offset,size_type& pos)
+		{
+			pos = pos_ref.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				const size_type k = count_slots(pos,n,offset);
+				if (k==0)
+				{
+					const size_type seq = sequences[pos&mask].load(std::memory_order_acquire);
+					//序号落后说明队列满/空,否则是别的线程已抢走pos,重新读取
+					if (ptrdiff_t(seq-(pos+offset))<0)
+					{
+						return 0;
+					}
+					pos = pos_ref.load(std::memory_order_relaxed);
+				}
+				else if (pos_ref.compare_exchange_weak(pos,pos+k,std::memory_order_relaxed))
+				{
+					return k;
+				}
+			}
+		}
+
+	public:
+		explicit mpmc_queue(size_type n):mask(round_up_pow2(max(n,size_type(2)))-1)
+		{
+			buffer = static_cast<T*>(::operator new(sizeof(T)*(mask+1)));
+			sequences = static_cast<sequence_type*>(::operator new(sizeof(sequence_type)*(mask+1)));
+			for (size_type i = 0; i <= mask; ++i)
+			{
+				new(sequences+i) sequence_type(i);
+			}
+			enqueue_pos.store(0,std::memory_order_relaxed);
+			dequeue_pos.store(0,std::memory_order_relaxed);
+		}
+		~mpmc_queue()
+		{
+			const size_type last = enqueue_pos.load(std::memory_order_relaxed);
+			for (size_type pos = dequeue_pos.load(std::memory_order_relaxed); pos != last; ++pos)
+			{
+				destroy(buffer+(pos&mask));
+			}
+			::operator delete(buffer);
+			::operator delete(sequences);
+		}
+
+		size_type capacity()const{return mask+1;}
+		//并发时只是近似值
+		size_type size()const
+		{
+			const size_type h = dequeue_pos.load(std::memory_order_acquire);
+			const size_type t = enqueue_pos.load(std::memory_order_acquire);
+			return t>h ? t-h : 0;
+		}
+		bool empty()const{return size()==0;}
+
+		bool try_push(const T& x)
+		{
+			return push_n(&x,1)==1;
+		}
+
+		bool try_pop(T& x)
+		{
+			return pop_n(&x,1)==1;
+		}
+
+		//队列满/空时让出时间片等待
+		void push(const T& x)
+		{
+			while (!try_push(x))
+				std::this_thread::yield();
+		}
+
+		void pop(T& x)
+		{
+			while (!try_pop(x))
+				std::this_thread::yield();
+		}
+
+		//最多写入n个元素,返回实际写入的个数
+		size_type push_n(const T* first,size_type n)
+		{
+			size_type pos;
+			n = claim(enqueue_pos,n,0,pos);
+			for (size_type i = 0; i != n; ++i)
+			{
+				construct(buffer+((pos+i)&mask),first[i]);
+				sequences[(pos+i)&mask].store(pos+i+1,std::memory_order_release);
+			}
+			return n;
+		}
+
+		//最多取出n个元素到dest,返回实际取出的个数
+		size_type pop_n(T* dest,size_type n)
+		{
+			size_type pos;
+			n = claim(dequeue_pos,n,1,pos);
+			for (size_type i = 0; i != n; ++i)
+			{
+				T* p = buffer+((pos+i)&mask);
+				dest[i] = *p;
+				destroy(p);
+				sequences[(pos+i)&mask].store(pos+i+mask+1,std::memory_order_release);
+			}
+			return n;
+		}
+	};
+}
+
+#endif
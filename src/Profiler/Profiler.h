@@ -10,6 +10,9 @@
 #include <utility>
 
 #ifdef WIN32
+#ifndef NOMINMAX
+#define NOMINMAX	//Windows.hmin/maxƻMINI_STL::min/max
+#endif
 #include <Windows.h>
 #include <Psapi.h>
 #pragma comment(lib, "psapi.lib")
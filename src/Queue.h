@@ -76,6 +76,10 @@ namespace MINI_STL
   		const_reference back()const {return seq.back();}
   		void push(const value_type& x){seq.push_back(x);}
   		void pop(){seq.pop_front();}
+		//批量入队/出队,Sequence需提供append/pop_front_n
+		template<class InputIterator>
+		void push(InputIterator first,InputIterator last){seq.append(first,last);}
+		void pop(size_type n){seq.pop_front_n(n);}
 
 		void swap(queue& x){seq.swap(x.seq);}
 
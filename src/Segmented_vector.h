@@ -0,0 +1,349 @@
+#ifndef _MINI_STL_SEGMENTED_VECTOR_H_
+#define _MINI_STL_SEGMENTED_VECTOR_H_
+
+#include <atomic>
+#include "Algorithm.h"
+#include "Allocator.h"
+#include "Construct.h"
+#include "Iterator.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace MINI_STL
+{
+	/************************************************************************/
+	/*	segmented_vector:只追加、元素地址稳定的vector
+		1.第k块容纳(first_block_size<<k)个元素,块大小按指数增长
+		2.块目录为定长数组,push_back不会移动已有元素
+		3.下标经一次位扫描即可定位到块与块内偏移
+		4.单个写线程push_back时,其他线程可无锁读取[0,size()),包括begin()/end()
+		5.块目录的槽是原子指针,end()可能读到写者正在安装的块
+		6.push_back会使停在未分配块上的迭代器(如旧的end())失效,并发读者每轮应从begin()+下标重新取迭代器
+	*/
+	/************************************************************************/
+	enum { segment_first_shift = 4 };
+	enum { segment_max_blocks = sizeof(size_t)*8-segment_first_shift };
+
+	//最高位1的位置,x必须非0
+	inline size_t segment_log2(size_t x)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+	#if defined(_WIN64)
+		_BitScanReverse64(&index,x);
+	#else
+		_BitScanReverse(&index,x);
+	#endif
+		return index;
+#elif defined(__GNUC__)
+		return sizeof(unsigned long long)*8-1-__builtin_clzll((unsigned long long)x);
+#else
+		size_t index = 0;
+		while (x>>=1)
+			++index;
+		return index;
+#endif
+	}
+
+	//第k块的元素个数
+	inline size_t segment_block_size(size_t k)
+	{
+		return size_t(1)<<(k+segment_first_shift);
+	}
+
+	//第k块首元素的下标
+	inline size_t segment_block_start(size_t k)
+	{
+		return segment_block_size(k)-segment_block_size(0);
+	}
+
+	//下标所在的块
+	inline size_t segment_block_of(size_t index)
+	{
+		return segment_log2(index+segment_block_size(0))-segment_first_shift;
+	}
+
+	template<class T,class Ref,class Ptr>
+	struct segmented_vector_iterator
+	{
+		typedef segmented_vector_iterator<T,T&,T*>				iterator;
+		typedef segmented_vector_iterator<T,const T&,const T*>	const_iterator;
+
+		typedef random_access_iterator_tag	iterator_category;
+		typedef T							value_type;
+		typedef Ptr							pointer;
+		typedef Ref							reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+		typedef const std::atomic<T*>*		map_pointer;
+
+		T*	M_cur;
+		T*	M_first;
+		T*	M_last;
+		size_t	M_block;
+		map_pointer M_map;
+
+		segmented_vector_iterator():M_cur(0),M_first(0),M_last(0),M_block(0),M_map(0){}
+		segmented_vector_iterator(map_pointer map,size_t index):M_map(map){set_index(index);}
+		segmented_vector_iterator(const iterator& x)
+			:M_cur(x.M_cur),M_first(x.M_first),M_last(x.M_last),M_block(x.M_block),M_map(x.M_map){}
+
+		void set_block(size_t block)
+		{
+			M_block = block;
+			M_first = M_map[block].load(std::memory_order_acquire);
+			M_last = M_first ? M_first+segment_block_size(block) : 0;
+		}
+
+		void set_index(size_t index)
+		{
+			size_t block = segment_block_of(index);
+			set_block(block);
+			M_cur = M_first+(index-segment_block_start(block));
+		}
+
+		size_t index()const
+		{
+			return segment_block_start(M_block)+(M_cur-M_first);
+		}
+
+		reference operator*()const{return *M_cur;}
+		pointer operator->()const{return M_cur;}
+
+		segmented_vector_iterator& operator++()
+		{
+			++M_cur;
+			if (M_cur==M_last)
+			{
+				set_block(M_block+1);
+				M_cur = M_first;
+			}
+			return *this;
+		}
+
+		segmented_vector_iterator operator++(int)
+		{
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		segmented_vector_iterator& operator--()
+		{
+			if (M_cur==M_first)
+			{
+				set_block(M_block-1);
+				M_cur = M_last;
+			}
+			--M_cur;
+			return *this;
+		}
+
+		segmented_vector_iterator operator--(int)
+		{
+			auto temp = *this;
+			--*this;
+			return temp;
+		}
+
+		segmented_vector_iterator& operator+=(difference_type n)
+		{
+			difference_type offset = n+(M_cur-M_first);
+			if (offset>=0 && offset<M_last-M_first)
+			{
+				M_cur += n;
+			}
+			else
+			{
+				set_index(index()+n);
+			}
+			return *this;
+		}
+
+		segmented_vector_iterator operator+(difference_type n)const
+		{
+			auto temp = *this;
+			return temp += n;
+		}
+
+		segmented_vector_iterator& operator-=(difference_type n){return *this += -n;}
+
+		segmented_vector_iterator operator-(difference_type n)const
+		{
+			auto temp = *this;
+			return temp -= n;
+		}
+
+		difference_type operator-(const segmented_vector_iterator& x)const
+		{
+			return difference_type(index())-difference_type(x.index());
+		}
+
+		reference operator[](difference_type n)const{return *(*this+n);}
+
+		//块首位置在块安装前后取得的迭代器M_cur不同(空/非空),按块内偏移比较
+		bool operator==(const segmented_vector_iterator& x)const
+		{
+			return M_block==x.M_block && (M_cur==x.M_cur || (M_cur==M_first && x.M_cur==x.M_first));
+		}
+		bool operator!=(const segmented_vector_iterator& x)const{return !(*this==x);}
+		bool operator<(const segmented_vector_iterator& x)const
+		{
+			return (M_block==x.M_block) ? (M_cur-M_first<x.M_cur-x.M_first) : (M_block<x.M_block);
+		}
+		bool operator>(const segmented_vector_iterator& x)const{return x<*this;}
+		bool operator<=(const segmented_vector_iterator& x)const{return !(*this>x);}
+		bool operator>=(const segmented_vector_iterator& x)const{return !(*this<x);}
+	};
+
+	template<class T>
+	class segmented_vector
+	{
+	public:
+		typedef T							value_type;
+		typedef T*							pointer;
+		typedef const T*					const_pointer;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+
+		typedef segmented_vector_iterator<T,T&,T*>				iterator;
+		typedef segmented_vector_iterator<T,const T&,const T*>	const_iterator;
+
+	protected:
+		typedef Allocator<T> dataAllocator;
+
+		std::atomic<T*>	blocks[segment_max_blocks];     //块目录,地址固定
+		std::atomic<size_type> ele_nums;    //已发布的元素个数
+		size_type block_nums;               //已分配的块数
+
+		void initialize()
+		{
+			for (size_type i = 0; i != segment_max_blocks; ++i)
+			{
+				blocks[i].store(0,std::memory_order_relaxed);
+			}
+			ele_nums.store(0,std::memory_order_relaxed);
+			block_nums = 0;
+		}
+		void allocate_block()
+		{
+			blocks[block_nums].store(dataAllocator::allocate(segment_block_size(block_nums)),std::memory_order_release);
+			++block_nums;
+		}
+
+	public:
+		segmented_vector(){initialize();}
+		segmented_vector(const segmented_vector& x)
+		{
+			initialize();
+			for (const_iterator it = x.begin(); it != x.end(); ++it)
+			{
+				push_back(*it);
+			}
+		}
+		segmented_vector& operator=(const segmented_vector& x)
+		{
+			if (this!=&x)
+			{
+				clear();
+				for (const_iterator it = x.begin(); it != x.end(); ++it)
+				{
+					push_back(*it);
+				}
+			}
+			return *this;
+		}
+		~segmented_vector()
+		{
+			clear();
+			for (size_type i = 0; i != block_nums; ++i)
+			{
+				dataAllocator::deallocate(blocks[i].load(std::memory_order_relaxed),segment_block_size(i));
+			}
+		}
+
+		//读操作,可与单个写线程的push_back并发执行
+		size_type size()const{return ele_nums.load(std::memory_order_acquire);}
+		bool empty()const{return size()==0;}
+		size_type capacity()const{return segment_block_start(block_nums);}
+
+		reference operator[](size_type n)
+		{
+			const size_type block = segment_block_of(n);
+			return blocks[block].load(std::memory_order_acquire)[n-segment_block_start(block)];
+		}
+		const_reference operator[](size_type n)const
+		{
+			const size_type block = segment_block_of(n);
+			return blocks[block].load(std::memory_order_acquire)[n-segment_block_start(block)];
+		}
+		reference front(){return *blocks[0].load(std::memory_order_acquire);}
+		reference back(){return (*this)[size()-1];}
+
+		iterator begin(){return iterator(blocks,0);}
+		iterator end(){return iterator(blocks,size());}
+		const_iterator begin()const{return const_iterator(blocks,0);}
+		const_iterator end()const{return const_iterator(blocks,size());}
+
+		//写操作,同一时刻只允许一个线程调用
+		void push_back(const T& x)
+		{
+			const size_type n = ele_nums.load(std::memory_order_relaxed);
+			const size_type block = segment_block_of(n);
+			if (block==block_nums)
+			{
+				allocate_block();
+			}
+			construct(blocks[block].load(std::memory_order_relaxed)+(n-segment_block_start(block)),x);
+			ele_nums.store(n+1,std::memory_order_release);
+		}
+
+		void pop_back()
+		{
+			const size_type n = ele_nums.load(std::memory_order_relaxed)-1;
+			ele_nums.store(n,std::memory_order_release);
+			destroy(&(*this)[n]);
+		}
+
+		//预先分配块,之后的push_back不再申请内存
+		void reserve(size_type n)
+		{
+			while (capacity()<n)
+			{
+				allocate_block();
+			}
+		}
+
+		//析构全部元素,保留已分配的块
+		void clear()
+		{
+			const size_type n = size();
+			ele_nums.store(0,std::memory_order_release);
+			for (size_type block = 0; block != block_nums && segment_block_start(block)<n; ++block)
+			{
+				const size_type len = min(segment_block_size(block),n-segment_block_start(block));
+				T* p = blocks[block].load(std::memory_order_relaxed);
+				destroy(p,p+len);
+			}
+		}
+
+		void swap(segmented_vector& x)
+		{
+			for (size_type i = 0; i != segment_max_blocks; ++i)
+			{
+				T* p = blocks[i].load(std::memory_order_relaxed);
+				blocks[i].store(x.blocks[i].load(std::memory_order_relaxed),std::memory_order_relaxed);
+				x.blocks[i].store(p,std::memory_order_relaxed);
+			}
+			MINI_STL::swap(block_nums,x.block_nums);
+			const size_type n = ele_nums.load(std::memory_order_relaxed);
+			ele_nums.store(x.ele_nums.load(std::memory_order_relaxed),std::memory_order_relaxed);
+			x.ele_nums.store(n,std::memory_order_relaxed);
+		}
+	};
+}
+
+#endif
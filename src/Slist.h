@@ -3,6 +3,7 @@
 
 #include "Iterator.h"
 #include "Allocator.h"
+#include "Functional.h"
 
 namespace MINI_STL
 {
@@ -137,40 +138,247 @@ namespace MINI_STL
 
 	private:
 		list_node_base head;
+		list_node_base* tail;    //最后一个结点,空链表时指向head
+		size_type ele_nums;
+
+		void reset()
+		{
+			head.next = nullptr;
+			tail = &head;
+			ele_nums = 0;
+		}
 
 	public:
-		slist() {head.next = nullptr;}
+		slist() {reset();}
 		~slist() {clear();}
 
+		iterator before_begin() {return iterator((list_node*)&head);}
 		iterator begin() {return iterator((list_node*)head.next);}
 		iterator end() {return iterator(nullptr);}
-		size_type size()const {return slist_size(head.next);}
+		size_type size()const {return ele_nums;}
 		bool empty()const {return head.next==nullptr;}
 
 		reference front() { return ((list_node*)head.next)->data;}
-		void push_front(const value_type& x) {slist_make_link(&head,create_node(x));}
-		void pop_front() 
+		reference back() { return ((list_node*)tail)->data;}
+		void push_front(const value_type& x) {insert_after(before_begin(),x);}
+		void push_back(const value_type& x) {insert_after(iterator((list_node*)tail),x);}
+		void pop_front() {erase_after(before_begin());}
+
+		//在position之后插入,O(1)
+		iterator insert_after(iterator position,const value_type& x)
+		{
+			list_node_base* node = slist_make_link(position.node,create_node(x));
+			if (position.node==tail)
+			{
+				tail = node;
+			}
+			++ele_nums;
+			return iterator((list_node*)node);
+		}
+
+		//删除position之后的结点,返回被删结点的下一个位置,O(1)
+		iterator erase_after(iterator position)
 		{
-			list_node* temp = (list_node*)head.next;
-			head.next = head.next->next;
-			destroy_node(temp);
+			list_node_base* node = position.node->next;
+			position.node->next = node->next;
+			if (node==tail)
+			{
+				tail = position.node;
+			}
+			destroy_node((list_node*)node);
+			--ele_nums;
+			return iterator((list_node*)position.node->next);
+		}
+
+		//删除(first,last)之间的结点
+		iterator erase_after(iterator first,iterator last)
+		{
+			while (first.node->next!=last.node)
+			{
+				erase_after(first);
+			}
+			return last;
 		}
 
+		//在position之前插入,需要O(n)查找前驱,尽量使用insert_after
 		iterator insert(iterator position,const value_type& x)
 		{
-			list_node_base* pre = slist_previous(&head,position.node);
-			list_node_base* node = slist_make_link(pre,create_node(x));
-			return iterator((list_node*)node);
+			list_node_base* pre = position.node==nullptr ? tail : slist_previous(&head,position.node);
+			return insert_after(iterator((list_node*)pre),x);
 		}
 
+		//需要O(n)查找前驱,尽量使用erase_after
 		iterator erase(iterator position)
 		{
 			list_node_base* pre = slist_previous(&head,position.node);
-			pre->next = pre->next->next;
-			destroy_node((list_node*)position.node);
-			return iterator((list_node*)pre->next);
+			return erase_after(iterator((list_node*)pre));
+		}
+
+		//把x的全部结点接到position之后,O(1)
+		void splice_after(iterator position,slist& x)
+		{
+			if (this==&x || x.empty())
+			{
+				return;
+			}
+			x.tail->next = position.node->next;
+			position.node->next = x.head.next;
+			if (position.node==tail)
+			{
+				tail = x.tail;
+			}
+			ele_nums += x.ele_nums;
+			x.reset();
+		}
+
+		//把x中(before_first,last)之间的结点移到position之后,需要O(k)统计结点个数
+		void splice_after(iterator position,slist& x,iterator before_first,iterator last)
+		{
+			list_node_base* first = before_first.node->next;
+			if (first==last.node)
+			{
+				return;
+			}
+			size_type n = 1;
+			list_node_base* before_last = first;
+			while (before_last->next!=last.node)
+			{
+				before_last = before_last->next;
+				++n;
+			}
+			before_first.node->next = last.node;
+			if (before_last==x.tail)
+			{
+				x.tail = before_first.node;
+			}
+			before_last->next = position.node->next;
+			position.node->next = first;
+			if (position.node==tail)
+			{
+				tail = before_last;
+			}
+			x.ele_nums -= n;
+			ele_nums += n;
+		}
+
+		//把x中prev之后的一个结点移到position之后
+		void splice_after(iterator position,slist& x,iterator prev)
+		{
+			list_node_base* node = prev.node->next;
+			if (position.node==prev.node || position.node==node)
+			{
+				return;
+			}
+			splice_after(position,x,prev,iterator((list_node*)node->next));
+		}
+
+		//合并两个有序链表,只修改指针,相等元素保持原有顺序
+		template<class Compare>
+		void merge(slist& x,Compare comp)
+		{
+			if (this==&x)
+			{
+				return;
+			}
+			list_node_base* cur = &head;
+			while (cur->next!=nullptr && x.head.next!=nullptr)
+			{
+				if (comp(((list_node*)x.head.next)->data,((list_node*)cur->next)->data))
+				{
+					list_node_base* node = x.head.next;
+					x.head.next = node->next;
+					node->next = cur->next;
+					cur->next = node;
+				}
+				cur = cur->next;
+			}
+			if (x.head.next!=nullptr)
+			{
+				cur->next = x.head.next;
+				tail = x.tail;
+			}
+			ele_nums += x.ele_nums;
+			x.reset();
+		}
+		void merge(slist& x) {merge(x,less<T>());}
+
+		//逐个翻转next指针,O(n)
+		void reverse()
+		{
+			if (ele_nums<2)
+			{
+				return;
+			}
+			list_node_base* cur = head.next;
+			list_node_base* prev = nullptr;
+			tail = cur;
+			while (cur!=nullptr)
+			{
+				list_node_base* next = cur->next;
+				cur->next = prev;
+				prev = cur;
+				cur = next;
+			}
+			head.next = prev;
 		}
 
+		//删除连续的重复元素
+		template<class BinaryPredicate>
+		void unique(BinaryPredicate pred)
+		{
+			list_node_base* cur = head.next;
+			if (cur==nullptr)
+			{
+				return;
+			}
+			while (cur->next!=nullptr)
+			{
+				if (pred(((list_node*)cur)->data,((list_node*)cur->next)->data))
+				{
+					erase_after(iterator((list_node*)cur));
+				}
+				else
+				{
+					cur = cur->next;
+				}
+			}
+		}
+		void unique() {unique(equal_to<T>());}
+
+		//自底向上归并排序:counter[i]存放2^i个有序结点,只搬动结点不申请内存
+		template<class Compare>
+		void sort(Compare comp)
+		{
+			if (ele_nums<2)
+			{
+				return;
+			}
+			slist carry;
+			slist counter[64];
+			int fill = 0;
+			while (!empty())
+			{
+				carry.splice_after(carry.before_begin(),*this,before_begin());
+				int i = 0;
+				while (i<fill && !counter[i].empty())
+				{
+					counter[i].merge(carry,comp);
+					carry.swap(counter[i++]);
+				}
+				carry.swap(counter[i]);
+				if (i==fill)
+				{
+					++fill;
+				}
+			}
+			for (int i = 1; i < fill; ++i)
+			{
+				counter[i].merge(counter[i-1],comp);
+			}
+			swap(counter[fill-1]);
+		}
+		void sort() {sort(less<T>());}
+
 		void clear()
 		{
 			while (head.next!=nullptr)
@@ -179,10 +387,22 @@ namespace MINI_STL
 				head.next = head.next->next;
 				destroy_node(temp);
 			}
+			reset();
 		}
 		void swap(slist& x)
 		{
 			MINI_STL::swap(head.next,x.head.next);
+			MINI_STL::swap(tail,x.tail);
+			MINI_STL::swap(ele_nums,x.ele_nums);
+			//空链表的tail指向自己的head
+			if (tail==&x.head)
+			{
+				tail = &head;
+			}
+			if (x.tail==&head)
+			{
+				x.tail = &x.head;
+			}
 		}
 	};
 }
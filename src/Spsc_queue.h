@@ -0,0 +1,180 @@
+#ifndef _MINI_STL_SPSC_QUEUE_H_
+#define _MINI_STL_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <new>
+#include <thread>
+#include "Algorithm.h"
+#include "Construct.h"
+
+namespace MINI_STL
+{
+	enum { cache_line_size = 64 };
+
+	//不小于n的最小2的幂
+	inline size_t round_up_pow2(size_t n)
+	{
+		size_t x = 1;
+		while (x<n)
+			x <<= 1;
+		return x;
+	}
+
+	/************************************************************************/
+	/*	spsc_queue:单生产者单消费者的有界无锁环形队列
+		1.容量向上取整为2的幂,下标单调递增,与mask相与得到槽位
+		2.head(消费者)与tail(生产者)分处不同缓存行,避免伪共享
+		3.双方各自缓存对方的下标,只有缓存值显示满/空时才重新读取
+		4.push/try_push/push_n只能由生产者调用,其余出队操作只能由消费者调用
+	*/
+	/************************************************************************/
+	template<class T>
+	class spsc_queue
+	{
+	public:
+		typedef T			value_type;
+		typedef T&			reference;
+		typedef const T&	const_reference;
+		typedef size_t		size_type;
+
+	private:
+		T* buffer;
+		size_type mask;
+		char pad0[cache_line_size];
+
+		std::atomic<size_type> head;   //消费者写
+		size_type cached_tail;         //消费者读到的tail
+		char pad1[cache_line_size];
+
+		std::atomic<size_type> tail;   //生产者写
+		size_type cached_head;         //生产者读到的head
+		char pad2[cache_line_size];
+
+		spsc_queue(const spsc_queue&);
+		spsc_queue& operator=(const spsc_queue&);
+
+		//生产者:可写入的槽位数
+		size_type free_slots(size_type t)
+		{
+			size_type free = capacity()-(t-cached_head);
+			if (free==0)
+			{
+				cached_head = head.load(std::memory_order_acquire);
+				free = capacity()-(t-cached_head);
+			}
+			return free;
+		}
+
+		//消费者:可读取的元素数,pop()不更新cached_tail,所以缓存值可能落后于h
+		size_type ready_slots(size_type h)
+		{
+			size_type ready = cached_tail-h;
+			if (ready==0 || ready>capacity())
+			{
+				cached_tail = tail.load(std::memory_order_acquire);
+				ready = cached_tail-h;
+			}
+			return ready;
+		}
+
+	public:
+		explicit spsc_queue(size_type n)
+			:mask(round_up_pow2(max(n,size_type(2)))-1),cached_tail(0),cached_head(0)
+		{
+			buffer = static_cast<T*>(::operator new(sizeof(T)*(mask+1)));
+			head.store(0,std::memory_order_relaxed);
+			tail.store(0,std::memory_order_relaxed);
+		}
+		~spsc_queue()
+		{
+			const size_type t = tail.load(std::memory_order_relaxed);
+			for (size_type h = head.load(std::memory_order_relaxed); h != t; ++h)
+			{
+				destroy(buffer+(h&mask));
+			}
+			::operator delete(buffer);
+		}
+
+		size_type capacity()const{return mask+1;}
+		//并发时只是近似值
+		size_type size()const{return tail.load(std::memory_order_acquire)-head.load(std::memory_order_acquire);}
+		bool empty()const{return size()==0;}
+
+		//生产者操作
+		bool try_push(const T& x)
+		{
+			const size_type t = tail.load(std::memory_order_relaxed);
+			if (free_slots(t)==0)
+			{
+				return false;
+			}
+			construct(buffer+(t&mask),x);
+			tail.store(t+1,std::memory_order_release);
+			return true;
+		}
+
+		//队列满时让出时间片等待消费者
+		void push(const T& x)
+		{
+			while (!try_push(x))
+				std::this_thread::yield();
+		}
+
+		//最多写入n个元素,返回实际写入的个数
+		size_type push_n(const T* first,size_type n)
+		{
+			const size_type t = tail.load(std::memory_order_relaxed);
+			n = min(n,free_slots(t));
+			for (size_type i = 0; i != n; ++i)
+			{
+				construct(buffer+((t+i)&mask),first[i]);
+			}
+			tail.store(t+n,std::memory_order_release);
+			return n;
+		}
+
+		//消费者操作,front/pop要求队列非空
+		reference front()
+		{
+			return buffer[head.load(std::memory_order_relaxed)&mask];
+		}
+
+		void pop()
+		{
+			const size_type h = head.load(std::memory_order_relaxed);
+			destroy(buffer+(h&mask));
+			head.store(h+1,std::memory_order_release);
+		}
+
+		bool try_pop(T& x)
+		{
+			const size_type h = head.load(std::memory_order_relaxed);
+			if (ready_slots(h)==0)
+			{
+				return false;
+			}
+			T* p = buffer+(h&mask);
+			x = *p;
+			destroy(p);
+			head.store(h+1,std::memory_order_release);
+			return true;
+		}
+
+		//最多取出n个元素到dest,返回实际取出的个数
+		size_type pop_n(T* dest,size_type n)
+		{
+			const size_type h = head.load(std::memory_order_relaxed);
+			n = min(n,ready_slots(h));
+			for (size_type i = 0; i != n; ++i)
+			{
+				T* p = buffer+((h+i)&mask);
+				dest[i] = *p;
+				destroy(p);
+			}
+			head.store(h+n,std::memory_order_release);
+			return n;
+		}
+	};
+}
+
+#endif
@@ -74,6 +74,95 @@ namespace MINI_STL
 				fl.erase_after(fit);
 			}
 			assert(MINI_STL::Test::container_equal(sl,fl));
+
+			sl.insert_after(sl.before_begin(),7);
+			fl.insert_after(fl.before_begin(),7);
+			sl.erase_after(sl.begin());
+			fl.erase_after(fl.begin());
+			assert(sl.size()==5);
+			assert(MINI_STL::Test::container_equal(sl,fl));
+
+			//push_back与insert(end())都走缓存的尾结点
+			sl.push_back(100);
+			sl.insert(sl.end(),101);
+			auto flast = fl.before_begin();
+			for (auto i = fl.begin(); i != fl.end(); ++i)
+				flast = i;
+			flast = fl.insert_after(flast,100);
+			fl.insert_after(flast,101);
+			assert(sl.size()==7 && sl.back()==101);
+			assert(MINI_STL::Test::container_equal(sl,fl));
+
+			MINI_STL::slist<int> sl2;
+			sl2.push_back(1);
+			sl2.push_back(2);
+			sl.splice_after(sl.before_begin(),sl2);
+			assert(sl2.empty() && sl2.size()==0);
+			assert(sl.size()==9 && sl.front()==1 && sl.back()==101);
+			sl.erase_after(sl.before_begin(),sl.end());
+			assert(sl.empty() && sl.size()==0);
+			sl.push_back(5);
+			assert(sl.front()==5 && sl.back()==5);
+
+			sl.swap(sl2);
+			assert(sl.empty() && sl2.size()==1);
+			sl.push_back(6);
+			sl2.push_back(7);
+			assert(sl.front()==6 && sl2.back()==7 && sl2.size()==2);
+
+			//sort/unique/reverse/merge与forward_list对比
+			sl.clear();
+			fl.clear();
+			for (int i = 0; i != 1000; ++i)
+			{
+				int v = (i*7919)%101;
+				sl.push_front(v);
+				fl.push_front(v);
+			}
+			sl.sort();
+			fl.sort();
+			assert(sl.size()==1000 && sl.back()==100);
+			assert(MINI_STL::Test::container_equal(sl,fl));
+			sl.unique();
+			fl.unique();
+			assert(sl.size()==101 && sl.back()==100);
+			assert(MINI_STL::Test::container_equal(sl,fl));
+			sl.reverse();
+			fl.reverse();
+			assert(sl.front()==100 && sl.back()==0);
+			assert(MINI_STL::Test::container_equal(sl,fl));
+			sl.reverse();
+			fl.reverse();
+
+			MINI_STL::slist<int> odd;
+			std::forward_list<int> fodd;
+			for (int i = 99; i >= -1; i -= 2)
+			{
+				odd.push_front(i);
+				fodd.push_front(i);
+			}
+			sl.merge(odd);
+			fl.merge(fodd);
+			assert(odd.empty() && sl.size()==152 && sl.back()==100);
+			assert(MINI_STL::Test::container_equal(sl,fl));
+			sl.sort(std::greater<int>());
+			fl.sort(std::greater<int>());
+			assert(MINI_STL::Test::container_equal(sl,fl));
+
+			//把前3个元素移到另一个链表末尾,再把其中一个移回来
+			sl2.clear();
+			sl2.push_back(-10);
+			auto last = sl.begin();
+			MINI_STL::advance(last,3);
+			sl2.splice_after(sl2.begin(),sl,sl.before_begin(),last);
+			assert(sl.size()==149 && sl.front()==98 && sl2.size()==4 && sl2.back()==99);
+			sl.splice_after(sl.before_begin(),sl2,sl2.begin());
+			assert(sl.size()==150 && sl.front()==100 && sl2.size()==3);
+			sl2.push_back(5);
+			auto prev = sl2.begin();
+			MINI_STL::advance(prev,2);
+			sl2.splice_after(sl2.begin(),sl2,prev);
+			assert(sl2.size()==4 && *(++sl2.begin())==5 && sl2.back()==99);
 			std::cout<<"SList test ok!"<<std::endl;
 		}
 
@@ -274,6 +363,70 @@ namespace MINI_STL
 			assert(it==ht.end());
 			auto it2 = ht.find(108);
 			assert(*it2==108);
+
+			//渐进式重建:迁移过程中的插入、删除、查找、遍历和复制
+			typedef MINI_STL::hashtable<int,int,MINI_STL::hash<int>,identity<int>,std::equal_to<int>> int_table;
+			int_table inc(50,MINI_STL::hash<int>(),std::equal_to<int>());
+			inc.set_incremental_rehash(true);
+			std::set<int> ss;
+			std::mt19937 rng(46);
+			bool seen_rehashing = false;
+			for (int i=0;i<100000;++i)
+			{
+				const int k = int(rng()%20000);
+				if (rng()%4)
+				{
+					assert(inc.insert_unique(k).second==ss.insert(k).second);
+				}
+				else
+				{
+					assert(inc.erase(k)==ss.erase(k));
+				}
+				if (inc.rehashing() && !seen_rehashing)
+				{
+					seen_rehashing = true;
+					size_t n = 0;
+					for (auto it = inc.begin(); it != inc.end(); ++it,++n)
+					{
+						assert(ss.count(*it)==1);
+					}
+					assert(n==ss.size());
+					int_table copy(inc);
+					assert(copy==inc);
+					copy.erase(*ss.begin());
+					assert(!(copy==inc));
+				}
+			}
+			assert(seen_rehashing);
+			assert(inc.size()==ss.size());
+			for (int k=0;k<20000;++k)
+			{
+				assert((inc.find(k)!=inc.end())==(ss.count(k)==1));
+			}
+			inc.set_incremental_rehash(false);
+			assert(!inc.rehashing());
+
+			//迁移过程中边遍历边按键删除:每个元素恰好访问一次
+			int_table er(50,MINI_STL::hash<int>(),std::equal_to<int>());
+			er.set_incremental_rehash(true);
+			for (int k=0;!er.rehashing();++k)
+			{
+				er.insert_unique(k);
+			}
+			const size_t before = er.size();
+			std::set<int> visited;
+			for (auto it = er.begin(); it != er.end(); )
+			{
+				const int k = *it;
+				++it;
+				assert(visited.insert(k).second);
+				if (k%2)
+				{
+					er.erase(k);
+				}
+			}
+			assert(visited.size()==before && er.size()==before-before/2);
+			assert(er.rehashing());
 			std::cout<<"Hashtable test ok!"<<std::endl;
 		}
 
@@ -295,9 +448,454 @@ namespace MINI_STL
 			s.erase(44);
 			assert(s.find(30)==s.end());
 			assert(s.find(44)==s.end());
+
+			//2的幂桶数:恒等哈希的低位相同的键也要能分散开,遍历结果与std::set一致
+			hashset<int,MINI_STL::hash<int>,equal_to<int>,pow2_bucket_policy> ps;
+			std::set<int> ss;
+			for (int i=0;i<5000;++i)
+			{
+				assert(ps.insert(i<<10).second);
+				ss.insert(i<<10);
+			}
+			assert(!ps.insert(0).second);
+			for (int i=0;i<5000;i+=2)
+			{
+				assert(ps.erase(i<<10)==1);
+				ss.erase(i<<10);
+			}
+			assert(ps.size()==ss.size());
+			std::vector<int> v;
+			for (auto it = ps.begin(); it != ps.end(); ++it)
+			{
+				v.push_back(*it);
+			}
+			std::sort(v.begin(),v.end());
+			assert(MINI_STL::Test::container_equal(v,ss));
+
+			//预留后插入不再扩容;负载因子上限控制桶数
+			hashset<int> rs;
+			rs.reserve(10000);
+			const size_t buckets = rs.bucket_count();
+			assert(buckets>=10000);
+			for (int i=0;i<10000;++i)
+			{
+				rs.insert(i);
+			}
+			assert(rs.bucket_count()==buckets && rs.load_factor()<=rs.max_load_factor());
+			hashset<int> sized(10000);
+			assert(sized.bucket_count()==buckets);
+			rs.max_load_factor(0.25f);
+			assert(rs.bucket_count()>=40000 && rs.load_factor()<=0.25f);
+			rs.max_load_factor(4.0f);
+			rs.rehash(0);
+			assert(rs.bucket_count()>=2500 && rs.bucket_count()<buckets && rs.load_factor()<=4.0f);
+			rs.max_load_factor(0.0f);
+			rs.max_load_factor(-1.0f);
+			rs.max_load_factor(std::numeric_limits<float>::quiet_NaN());
+			assert(rs.max_load_factor()==4.0f);
+			for (int i=0;i<10000;++i)
+			{
+				assert(rs.isContain(i));
+			}
+			rs.clear();
+			assert(rs.empty() && rs.begin()==rs.end());
+
+			//缓存哈希值:重建/迁移/拷贝后查找和遍历结果不变
+			typedef hashset<std::string,MINI_STL::hash<std::string>,equal_to<std::string>,pow2_bucket_policy,true> cached_set;
+			cached_set cs;
+			cs.set_incremental_rehash(true);
+			std::set<std::string> css;
+			for (int i=0;i<3000;++i)
+			{
+				const std::string key = "key/" + std::to_string(i*7);
+				assert(cs.insert(key).second);
+				css.insert(key);
+			}
+			assert(!cs.insert("key/0").second);
+			for (int i=0;i<3000;i+=3)
+			{
+				const std::string key = "key/" + std::to_string(i*7);
+				assert(cs.erase(key)==1);
+				css.erase(key);
+			}
+			cached_set cs_copy(cs);
+			cs.rehash(0);
+			assert(cs==cs_copy && cs.size()==css.size());
+			std::vector<std::string> sv;
+			for (auto it = cs_copy.begin(); it != cs_copy.end(); ++it)
+			{
+				assert(cs.isContain(*it));
+				sv.push_back(*it);
+			}
+			std::sort(sv.begin(),sv.end());
+			assert(MINI_STL::Test::container_equal(sv,css));
+			assert(!cs.isContain("key/1") && !cs.isContain("key/0"));
 			std::cout<<"Hashset test ok!"<<std::endl;
 		}
 
+		void hash_fcn_test()
+		{
+			//每个长度下改动任一字节都会改变哈希,说明尾部的重叠读取覆盖了全部字节
+			std::mt19937 rng(45);
+			unsigned char buf[200];
+			for (int i=0;i<200;++i)
+			{
+				buf[i] = (unsigned char)rng();
+			}
+			for (size_t len=1;len<=200;++len)
+			{
+				const size_t h = hash_bytes(buf,len);
+				assert(h==hash_bytes(buf,len));
+				assert(h!=hash_bytes(buf,len-1));
+				for (size_t j=0;j<len;++j)
+				{
+					buf[j] ^= 1;
+					assert(hash_bytes(buf,len)!=h);
+					buf[j] ^= 1;
+				}
+			}
+
+			//URL式的键:低位和高位的分桶都要均匀
+			const int N = 200000;
+			const int B = 4096;
+			std::vector<int> low(B,0),high(B,0);
+			std::set<size_t> distinct;
+			MINI_STL::hash<std::string> hs;
+			for (int i=0;i<N;++i)
+			{
+				const size_t h = hs("https://www.example.com/catalog/item?id="+std::to_string(i)+"&ref=home");
+				distinct.insert(h);
+				++low[h%B];
+				++high[(h>>(sizeof(size_t)*8-12))%B];
+			}
+			assert(distinct.size()+8>=size_t(N));
+			assert(*std::max_element(low.begin(),low.end())<2*N/B);
+			assert(*std::max_element(high.begin(),high.end())<2*N/B);
+
+			//雪崩:翻转输入的一位,输出约一半的位随之改变
+			size_t flipped = 0,trials = 0;
+			for (int k=0;k<200;++k)
+			{
+				unsigned char key[16];
+				for (int i=0;i<16;++i)
+				{
+					key[i] = (unsigned char)rng();
+				}
+				const size_t h = hash_bytes(key,16);
+				for (int bit=0;bit<128;++bit)
+				{
+					key[bit/8] ^= (unsigned char)(1<<(bit%8));
+					for (size_t d = h^hash_bytes(key,16); d; d &= d-1)
+					{
+						++flipped;
+					}
+					key[bit/8] ^= (unsigned char)(1<<(bit%8));
+					trials += sizeof(size_t)*8;
+				}
+			}
+			assert(flipped*100>=trials*45 && flipped*100<=trials*55);
+
+			seeded_hash<std::string> s1(1),s2(2),s1_copy(s1);
+			assert(s1("flood")==s1_copy("flood") && s1("flood")!=s2("flood"));
+			assert(seeded_hash<const char*>(7)("flood")==hash_bytes("flood",5,7));
+			assert(seeded_hash<int>(3)(42)==seeded_hash<int>(3)(42));
+			assert(MINI_STL::hash<const char*>()("abc")==hs(std::string("abc")));
+
+			assert(MINI_STL::hash<double>()(0.0)==MINI_STL::hash<double>()(-0.0));
+			assert(MINI_STL::hash<float>()(1.5f)!=MINI_STL::hash<float>()(-1.5f));
+			assert(MINI_STL::hash<long long>()(1LL<<40)!=MINI_STL::hash<long long>()(0));
+			int x = 0;
+			assert(MINI_STL::hash<int*>()(&x)==MINI_STL::hash<int*>()(&x));
+
+			hashset<MINI_STL::pair<int,int>> ps;
+			for (int i=0;i<100;++i)
+			{
+				for (int j=0;j<10;++j)
+				{
+					ps.insert(MINI_STL::pair<int,int>(i,j));
+				}
+			}
+			assert(ps.size()==1000);
+			assert(ps.isContain(MINI_STL::pair<int,int>(99,9)) && !ps.isContain(MINI_STL::pair<int,int>(9,99)));
+			std::cout<<"Hash_fcn test ok!"<<std::endl;
+		}
+
+		void flat_hash_set_test()
+		{
+			flat_hash_set<int> s;
+			std::set<int> ss;
+			assert(s.empty() && s.begin()==s.end());
+			assert(s.find(1)==s.end());
+			for (int i=0;i<1000;++i)
+			{
+				assert(s.insert(i*7).second);
+				ss.insert(i*7);
+			}
+			assert(!s.insert(7).second);
+			assert(s.size()==1000);
+			for (int i=0;i<7000;++i)
+			{
+				assert(s.isContain(i)==(ss.count(i)!=0));
+			}
+
+			//随机插入删除,大量墓碑会触发原地重建
+			std::mt19937 rng(43);
+			for (int i=0;i<200000;++i)
+			{
+				int k = int(rng()%4096);
+				if (rng()%2)
+				{
+					assert(s.insert(k).second==ss.insert(k).second);
+				}
+				else
+				{
+					assert(s.erase(k)==ss.erase(k));
+				}
+			}
+			assert(s.size()==ss.size());
+			std::vector<int> v;
+			for (auto it = s.begin(); it != s.end(); ++it)
+			{
+				v.push_back(*it);
+			}
+			std::sort(v.begin(),v.end());
+			assert(MINI_STL::Test::container_equal(v,ss));
+
+			flat_hash_set<int> s2(s);
+			assert(s2.size()==s.size());
+			for (auto it = s.begin(); it != s.end(); ++it)
+			{
+				assert(s2.isContain(*it));
+			}
+			s2.erase(s2.begin());
+			assert(s2.size()+1==s.size());
+			s.clear();
+			assert(s.empty() && s.begin()==s.end());
+			s.swap(s2);
+			assert(s2.empty() && s.size()+1==ss.size());
+
+			flat_hash_set<int> s3(1000);
+			const size_t cap = s3.capacity();
+			for (int i=0;i<1000;++i)
+			{
+				s3.insert(i);
+			}
+			assert(s3.capacity()==cap);
+			std::cout<<"Flat_hash_set test ok!"<<std::endl;
+		}
+
+		//记录默认构造的次数
+		int default_constructed = 0;
+		struct default_counter
+		{
+			int value;
+			default_counter():value(0){++default_constructed;}
+		};
+
+		void flat_hash_map_test()
+		{
+			flat_hash_map<int,std::string> m;
+			std::map<int,std::string> sm;
+			for (int i=0;i<2000;++i)
+			{
+				m[i%1500] += std::to_string(i);
+				sm[i%1500] += std::to_string(i);
+			}
+			assert(m.size()==sm.size());
+			for (auto it = sm.begin(); it != sm.end(); ++it)
+			{
+				auto f = m.find(it->first);
+				assert(f!=m.end() && f->second==it->second);
+			}
+			assert(m.count(1499)==1 && m.count(1500)==0);
+			for (int i=0;i<1500;i+=3)
+			{
+				assert(m.erase(i)==1);
+				sm.erase(i);
+			}
+			assert(m.erase(0)==0);
+			assert(m.size()==sm.size());
+			auto ret = m.insert(MINI_STL::make_pair(1,std::string("x")));
+			assert(!ret.second && ret.first->second==sm[1]);
+
+			const flat_hash_map<int,std::string>& cm = m;
+			size_t n = 0;
+			for (auto it = cm.begin(); it != cm.end(); ++it,++n)
+			{
+				assert(sm[it->first]==it->second);
+			}
+			assert(n==sm.size());
+
+			//operator[]命中时不构造新的值
+			flat_hash_map<int,default_counter> dm;
+			dm[1].value = 5;
+			default_constructed = 0;
+			assert(dm[1].value==5 && default_constructed==0);
+			dm[2];
+			assert(default_constructed==1 && dm.size()==2);
+			std::cout<<"Flat_hash_map test ok!"<<std::endl;
+		}
+
+		void hashmap_test()
+		{
+			hashmap<std::string,int> m;
+			std::map<std::string,int> sm;
+			for (int i=0;i<3000;++i)
+			{
+				const std::string key = std::to_string(i%2000);
+				m[key] += i;
+				sm[key] += i;
+			}
+			assert(m.size()==sm.size());
+			for (auto it = sm.begin(); it != sm.end(); ++it)
+			{
+				auto f = m.find(it->first);
+				assert(f!=m.end() && f->second==it->second && m.count(it->first)==1);
+			}
+			assert(m.count("2000")==0);
+			auto r = m.equal_range("7");
+			assert(r.first!=r.second && ++r.first==r.second);
+			assert(!m.insert(MINI_STL::make_pair(std::string("7"),0)).second);
+
+			hashmap<std::string,int> copy(m);
+			assert(copy==m);
+			copy["7"] = -1;
+			assert(copy!=m);
+			copy = m;
+			assert(copy==m);
+			for (int i=0;i<2000;i+=4)
+			{
+				const std::string key = std::to_string(i);
+				assert(m.erase(key)==1);
+				sm.erase(key);
+			}
+			m.erase(m.find("1"));
+			sm.erase("1");
+			assert(m.size()==sm.size() && copy.size()==2000);
+			size_t n = 0;
+			for (auto it = m.begin(); it != m.end(); ++it,++n)
+			{
+				assert(sm[it->first]==it->second);
+			}
+			assert(n==sm.size());
+			m.erase(m.begin(),m.end());
+			assert(m.empty() && m.begin()==m.end());
+
+			hashmap<int,default_counter> dm;
+			dm[1].value = 5;
+			default_constructed = 0;
+			assert(dm[1].value==5 && default_constructed==0);
+			dm[2];
+			assert(default_constructed==1 && dm.size()==2);
+			std::cout<<"Hashmap test ok!"<<std::endl;
+		}
+
+		void hash_multiset_test()
+		{
+			hash_multiset<int,MINI_STL::hash<int>,equal_to<int>,pow2_bucket_policy> s;
+			std::multiset<int> ss;
+			s.set_incremental_rehash(true);
+			for (int i=0;i<5000;++i)
+			{
+				s.insert(i%700);
+				ss.insert(i%700);
+			}
+			assert(s.size()==ss.size());
+			for (int i=0;i<700;++i)
+			{
+				assert(s.count(i)==ss.count(i));
+				auto r = s.equal_range(i);
+				assert(size_t(MINI_STL::distance(r.first,r.second))==ss.count(i));
+				for (auto it = r.first; it != r.second; ++it)
+				{
+					assert(*it==i);
+				}
+			}
+			assert(s.count(700)==0 && s.equal_range(700).first==s.end());
+
+			//重复元素遍历时相邻
+			std::vector<int> v;
+			for (auto it = s.begin(); it != s.end(); ++it)
+			{
+				v.push_back(*it);
+			}
+			for (size_t i=1;i<v.size();++i)
+			{
+				assert(v[i]==v[i-1] || MINI_STL::find(v.begin(),v.begin()+i,v[i])==v.begin()+i);
+			}
+
+			hash_multiset<int,MINI_STL::hash<int>,equal_to<int>,pow2_bucket_policy> copy(s);
+			copy.rehash(0);
+			assert(copy==s);
+			//删除一段相等元素中的一部分
+			auto r = s.equal_range(5);
+			auto mid = r.first;
+			++mid;
+			s.erase(mid,r.second);
+			ss.erase(5);
+			ss.insert(5);
+			assert(s.count(5)==1 && copy!=s);
+			assert(s.erase(6)==ss.erase(6));
+			s.erase(s.find(7));
+			ss.erase(ss.find(7));
+			assert(s.size()==ss.size());
+			v.clear();
+			for (auto it = s.begin(); it != s.end(); ++it)
+			{
+				v.push_back(*it);
+			}
+			std::sort(v.begin(),v.end());
+			assert(MINI_STL::Test::container_equal(v,ss));
+			std::cout<<"Hash_multiset test ok!"<<std::endl;
+		}
+
+		void hash_multimap_test()
+		{
+			hash_multimap<std::string,int,MINI_STL::hash<std::string>,equal_to<std::string>,prime_bucket_policy,true> m;
+			std::multimap<std::string,int> sm;
+			for (int i=0;i<3000;++i)
+			{
+				const std::string key = "k" + std::to_string(i%400);
+				m.insert(MINI_STL::make_pair(key,i));
+				sm.insert(std::make_pair(key,i));
+			}
+			assert(m.size()==sm.size());
+			for (int i=0;i<400;++i)
+			{
+				const std::string key = "k" + std::to_string(i);
+				auto r = m.equal_range(key);
+				std::vector<int> got,want;
+				for (auto it = r.first; it != r.second; ++it)
+				{
+					got.push_back(it->second);
+				}
+				for (auto it = sm.lower_bound(key); it != sm.upper_bound(key); ++it)
+				{
+					want.push_back(it->second);
+				}
+				std::sort(got.begin(),got.end());
+				assert(got==want && m.count(key)==want.size());
+			}
+
+			hash_multimap<std::string,int,MINI_STL::hash<std::string>,equal_to<std::string>,prime_bucket_policy,true> other;
+			for (auto it = sm.rbegin(); it != sm.rend(); ++it)
+			{
+				other.insert(MINI_STL::make_pair(it->first,it->second));
+			}
+			assert(other==m);
+			for (int i=0;i<400;i+=2)
+			{
+				const std::string key = "k" + std::to_string(i);
+				auto r = m.equal_range(key);
+				m.erase(r.first,r.second);
+				sm.erase(key);
+			}
+			assert(m.size()==sm.size() && m.count("k0")==0 && other!=m);
+			m.erase(m.begin(),m.end());
+			assert(m.empty());
+			std::cout<<"Hash_multimap test ok!"<<std::endl;
+		}
+
 		void union_set_test()
 		{
 			Union_set un(100);
@@ -309,6 +907,468 @@ namespace MINI_STL
 			assert(un.isConnected(11,10)==false);
 		}
 
+		void segmented_vector_test()
+		{
+			MINI_STL::segmented_vector<int> sv;
+			std::vector<int> v;
+			assert(sv.empty());
+			for (int i=0;i<100;++i)
+			{
+				sv.push_back(i);
+				v.push_back(i);
+			}
+			int* first = &sv[0];
+			int* mid = &sv[50];
+			for (int i=100;i<10000;++i)
+			{
+				sv.push_back(i);
+				v.push_back(i);
+			}
+			assert(first==&sv[0]&&mid==&sv[50]);
+			assert(sv.size()==10000);
+			assert(MINI_STL::Test::container_equal(sv,v));
+			for (int i=0;i<10000;i+=37)
+			{
+				assert(sv[i]==i);
+				assert(*(sv.begin()+i)==i);
+			}
+			assert(sv.end()-sv.begin()==10000);
+
+			sv.pop_back();
+			v.pop_back();
+			assert(sv.back()==9998);
+			MINI_STL::segmented_vector<int> sv2(sv);
+			assert(MINI_STL::Test::container_equal(sv2,v));
+
+			sv.clear();
+			assert(sv.empty());
+			sv.push_back(7);
+			assert(&sv[0]==first&&sv.front()==7);
+
+			//一个线程追加的同时另一个线程遍历[begin(),end())
+			MINI_STL::segmented_vector<int> sv3;
+			const int total = 100000;
+			std::thread writer([&sv3,total]{
+				for (int i=0;i<total;++i)
+					sv3.push_back(i);
+			});
+			for (int done=0;done!=total;)
+			{
+				auto last = sv3.end();
+				for (auto it=sv3.begin()+done;it!=last;++it,++done)
+				{
+					assert(*it==done);
+				}
+			}
+			writer.join();
+			std::cout<<"Segmented_vector test ok!"<<std::endl;
+		}
+
+		void concurrent_vector_test()
+		{
+			MINI_STL::concurrent_vector<int> cv;
+			assert(cv.empty());
+			for (int i=0;i<100;++i)
+			{
+				assert(*cv.push_back(i)==i);
+			}
+			int* first = &cv[0];
+			auto it = cv.grow_by(1000,7);
+			assert(it-cv.begin()==100);
+			assert(cv.size()==1100&&cv.back()==7&&first==&cv[0]);
+
+			MINI_STL::concurrent_vector<int> cv2;
+			const int nthreads = 4;
+			const int per_thread = 10000;
+			std::vector<std::thread> threads;
+			for (int t=0;t<nthreads;++t)
+			{
+				threads.push_back(std::thread([&cv2,t,per_thread]{
+					for (int i=0;i<per_thread;++i)
+						cv2.push_back(t*per_thread+i);
+				}));
+			}
+			for (int t=0;t<nthreads;++t)
+			{
+				threads[t].join();
+			}
+			assert(cv2.size()==nthreads*per_thread);
+			MINI_STL::vector<int> v(cv2.begin(),cv2.end());
+			std::sort(v.begin(),v.end());
+			for (int i=0;i<nthreads*per_thread;++i)
+			{
+				assert(v[i]==i);
+			}
+
+			//追加的同时遍历:[begin(),end())内只能看到已构造好的元素
+			MINI_STL::concurrent_vector<std::string> cv3;
+			threads.clear();
+			for (int t=0;t<nthreads;++t)
+			{
+				threads.push_back(std::thread([&cv3,per_thread]{
+					for (int i=0;i<per_thread;++i)
+						cv3.push_back("x");
+				}));
+			}
+			for (auto it=cv3.begin();it!=cv3.begin()+nthreads*per_thread;)
+			{
+				for (auto last=cv3.end();it!=last;++it)
+				{
+					assert(*it=="x");
+				}
+			}
+			for (int t=0;t<nthreads;++t)
+			{
+				threads[t].join();
+			}
+			std::cout<<"Concurrent_vector test ok!"<<std::endl;
+		}
+
+		void spsc_queue_test()
+		{
+			MINI_STL::spsc_queue<std::string> q(5);
+			assert(q.capacity()==8&&q.empty());
+			for (int i=0;i<8;++i)
+			{
+				assert(q.try_push(std::to_string(i)));
+			}
+			assert(!q.try_push("full"));
+			assert(q.front()=="0");
+			q.pop();
+			std::string s;
+			assert(q.try_pop(s)&&s=="1");
+			std::string arr[8];
+			assert(q.pop_n(arr,8)==6&&arr[5]=="7");
+			assert(q.empty()&&!q.try_pop(s));
+			assert(q.push_n(arr,8)==8&&q.size()==8);
+
+			MINI_STL::spsc_queue<int> q2(1024);
+			const int N = 1000000;
+			std::thread producer([&q2,N]{
+				int buf[64];
+				int i = 0;
+				while (i<N)
+				{
+					if (i%3==0)
+					{
+						int n = MINI_STL::min(64,N-i);
+						for (int k=0;k<n;++k)
+							buf[k] = i+k;
+						int k = 0;
+						while (k<n)
+							k += (int)q2.push_n(buf+k,n-k);
+						i += n;
+					}
+					else
+					{
+						q2.push(i++);
+					}
+				}
+			});
+			int expect = 0;
+			int buf[32];
+			while (expect<N)
+			{
+				int n = (int)q2.pop_n(buf,32);
+				for (int k=0;k<n;++k)
+				{
+					assert(buf[k]==expect++);
+				}
+			}
+			producer.join();
+			assert(q2.empty());
+			std::cout<<"Spsc_queue test ok!"<<std::endl;
+		}
+
+		void mpmc_queue_test()
+		{
+			MINI_STL::mpmc_queue<std::string> q(3);
+			assert(q.capacity()==4&&q.empty());
+			std::string arr[6] = {"a","b","c","d","e","f"};
+			assert(q.push_n(arr,6)==4&&!q.try_push("g"));
+			std::string s;
+			assert(q.try_pop(s)&&s=="a");
+			assert(q.try_push("g")&&q.size()==4);
+			std::string out[6];
+			assert(q.pop_n(out,6)==4&&out[0]=="b"&&out[3]=="g");
+			assert(!q.try_pop(s));
+
+			MINI_STL::mpmc_queue<int> q2(256);
+			const int nthreads = 4;
+			const int per_thread = 50000;
+			std::vector<int> seen(nthreads*per_thread,0);
+			std::vector<std::thread> threads;
+			for (int t=0;t<nthreads;++t)
+			{
+				threads.push_back(std::thread([&q2,t,per_thread]{
+					int buf[16];
+					for (int i=0;i<per_thread;)
+					{
+						if (i%2==0)
+						{
+							q2.push(t*per_thread+i++);
+						}
+						else
+						{
+							int n = MINI_STL::min(16,per_thread-i);
+							for (int k=0;k<n;++k)
+								buf[k] = t*per_thread+i+k;
+							int k = 0;
+							while (k<n)
+								k += (int)q2.push_n(buf+k,n-k);
+							i += n;
+						}
+					}
+				}));
+				threads.push_back(std::thread([&q2,&seen,t,per_thread]{
+					int buf[8];
+					for (int i=0;i<per_thread;)
+					{
+						int n = (int)q2.pop_n(buf,MINI_STL::min(8,per_thread-i));
+						for (int k=0;k<n;++k)
+							++seen[buf[k]];
+						i += n;
+					}
+				}));
+			}
+			for (size_t t=0;t<threads.size();++t)
+			{
+				threads[t].join();
+			}
+			assert(q2.empty());
+			for (int i=0;i<nthreads*per_thread;++i)
+			{
+				assert(seen[i]==1);
+			}
+			std::cout<<"Mpmc_queue test ok!"<<std::endl;
+		}
+
+		void concurrent_stack_test()
+		{
+			MINI_STL::concurrent_stack<std::string> st;
+			std::string s;
+			assert(st.empty()&&!st.try_pop(s));
+			st.push("a");
+			st.push("b");
+			assert(st.try_pop(s)&&s=="b");
+			st.push("c");
+			assert(st.try_pop(s)&&s=="c");
+			assert(st.try_pop(s)&&s=="a");
+			assert(st.empty());
+
+			MINI_STL::concurrent_stack<int> st2;
+			const int nthreads = 8;
+			const int per_thread = 20000;
+			std::vector<int> seen(nthreads*per_thread,0);
+			std::vector<std::thread> threads;
+			for (int t=0;t<nthreads;++t)
+			{
+				threads.push_back(std::thread([&st2,&seen,t,per_thread]{
+					int value;
+					for (int i=0;i<per_thread;++i)
+					{
+						st2.push(t*per_thread+i);
+						if (i%2==1)
+						{
+							while (!st2.try_pop(value))
+								;
+							++seen[value];
+							while (!st2.try_pop(value))
+								;
+							++seen[value];
+						}
+					}
+				}));
+			}
+			for (int t=0;t<nthreads;++t)
+			{
+				threads[t].join();
+			}
+			assert(st2.empty());
+			for (int i=0;i<nthreads*per_thread;++i)
+			{
+				assert(seen[i]==1);
+			}
+			std::cout<<"Concurrent_stack test ok!"<<std::endl;
+		}
+
+		void concurrent_hash_map_test()
+		{
+			MINI_STL::concurrent_hash_map<std::string,int> m(5);
+			assert(m.shard_count()==8 && m.empty());
+			int v = 0;
+			assert(m.insert("a",1) && !m.insert("a",2));
+			assert(m.find("a",v) && v==1 && !m.find("b",v));
+			assert(!m.upsert("a",3) && m.upsert("b",4));
+			assert(m.upsert("a",0,[](int& x){x += 10;})==false);
+			assert(m.visit("a",[&v](const int& x){v = x;}) && v==13);
+			assert(m.erase("b") && !m.erase("b") && m.size()==1);
+			m.clear();
+			assert(m.empty() && !m.contains("a"));
+
+			//各线程对自己的键做插入/计数/删除,同时对公共键累加
+			MINI_STL::concurrent_hash_map<int,int> cm;
+			const int nthreads = 8;
+			const int per_thread = 20000;
+			std::vector<std::thread> threads;
+			for (int t=0;t<nthreads;++t)
+			{
+				threads.push_back(std::thread([&cm,t,per_thread]{
+					for (int i=0;i<per_thread;++i)
+					{
+						const int key = t*per_thread+i;
+						cm.insert(key,key);
+						cm.upsert(-1-(i%16),1,[](int& x){++x;});
+						int value = 0;
+						if (!cm.find(key,value) || value!=key)
+						{
+							assert(false);
+						}
+						if (i%4==0)
+						{
+							cm.erase(key);
+						}
+					}
+				}));
+			}
+			for (int t=0;t<nthreads;++t)
+			{
+				threads[t].join();
+			}
+			assert(cm.size()==size_t(nthreads*per_thread/4*3+16));
+			int total = 0;
+			size_t n = 0;
+			cm.visit_all([&total,&n](const MINI_STL::pair<const int,int>& p){
+				if (p.first<0)
+				{
+					total += p.second;
+				}
+				++n;
+			});
+			assert(total==nthreads*per_thread && n==cm.size());
+			for (int key=0;key<nthreads*per_thread;++key)
+			{
+				assert(cm.contains(key)==(key%per_thread%4!=0));
+			}
+			std::cout<<"Concurrent_hash_map test ok!"<<std::endl;
+		}
+
+		//同时挂在两个链表和一棵树中的元素
+		struct intrusive_item
+		{
+			int key;
+			MINI_STL::intrusive_list_hook all_hook;
+			MINI_STL::intrusive_list_hook odd_hook;
+			MINI_STL::intrusive_rbtree_hook tree_hook;
+		};
+
+		struct intrusive_item_less
+		{
+			bool operator()(const intrusive_item& x,const intrusive_item& y)const{return x.key<y.key;}
+			bool operator()(const intrusive_item& x,int k)const{return x.key<k;}
+			bool operator()(int k,const intrusive_item& x)const{return k<x.key;}
+		};
+
+		void intrusive_list_test()
+		{
+			typedef MINI_STL::intrusive_list<intrusive_item,&intrusive_item::all_hook> all_list;
+			typedef MINI_STL::intrusive_list<intrusive_item,&intrusive_item::odd_hook> odd_list;
+			std::vector<intrusive_item> items(10);
+			all_list all;
+			odd_list odd;
+			for (int i = 0; i != 10; ++i)
+			{
+				items[i].key = i;
+				all.push_front(items[i]);
+				if (i%2==1)
+				{
+					odd.push_back(items[i]);
+				}
+			}
+			assert(all.size()==10 && odd.size()==5);
+			int expect = 9;
+			for (auto it = all.begin(); it != all.end(); ++it)
+			{
+				assert(it->key==expect--);
+			}
+			assert(odd.front().key==1 && odd.back().key==9);
+
+			//从一个链表中删除不影响另一个链表
+			all.remove(items[3]);
+			assert(!items[3].all_hook.is_linked() && items[3].odd_hook.is_linked());
+			assert(all.size()==9 && odd.size()==5);
+			auto it = odd_list::iterator_to(items[5]);
+			it = odd.erase(it);
+			assert(it->key==7 && odd.size()==4);
+			odd.insert(it,items[5]);
+			assert((--odd_list::iterator_to(items[7]))->key==5);
+
+			odd_list other;
+			other.push_back(items[0]);
+			other.splice(other.end(),odd);
+			assert(odd.empty() && other.size()==6 && other.back().key==9);
+			other.swap(odd);
+			assert(other.empty() && odd.size()==6 && odd.front().key==0);
+			odd.pop_front();
+			odd.pop_back();
+			assert(odd.size()==4 && odd.front().key==1 && odd.back().key==7);
+			odd.clear();
+			assert(odd.empty() && !items[1].odd_hook.is_linked());
+			std::cout<<"Intrusive_list test ok!"<<std::endl;
+		}
+
+		void intrusive_rbtree_test()
+		{
+			typedef MINI_STL::intrusive_rbtree<intrusive_item,&intrusive_item::tree_hook,intrusive_item_less> tree_type;
+			const int N = 1000;
+			std::vector<intrusive_item> items(N);
+			std::multiset<int> ms;
+			tree_type tree;
+			for (int i = 0; i != N; ++i)
+			{
+				items[i].key = (i*7919)%(N/2);
+				tree.insert_equal(items[i]);
+				ms.insert(items[i].key);
+			}
+			assert(tree.size()==ms.size());
+			auto mit = ms.begin();
+			for (auto it = tree.begin(); it != tree.end(); ++it, ++mit)
+			{
+				assert(it->key==*mit);
+			}
+
+			//删除一半元素后按key查找
+			for (int i = 0; i < N; i += 2)
+			{
+				tree.remove(items[i]);
+				ms.erase(ms.find(items[i].key));
+			}
+			assert(tree.size()==ms.size());
+			mit = ms.begin();
+			for (auto it = tree.begin(); it != tree.end(); ++it, ++mit)
+			{
+				assert(it->key==*mit);
+			}
+			for (int k = -1; k != N/2+1; ++k)
+			{
+				assert((tree.find(k)==tree.end())==(ms.find(k)==ms.end()));
+				auto lb = tree.lower_bound(k);
+				auto mlb = ms.lower_bound(k);
+				assert(lb==tree.end() ? mlb==ms.end() : lb->key==*mlb);
+			}
+
+			intrusive_item dup;
+			dup.key = items[1].key;
+			auto ret = tree.insert_unique(dup);
+			assert(!ret.second && ret.first->key==items[1].key);
+			dup.key = N;
+			ret = tree.insert_unique(dup);
+			assert(ret.second && (--tree.end())->key==N);
+			tree.clear();
+			assert(tree.empty() && tree.begin()==tree.end());
+			std::cout<<"Intrusive_rbtree test ok!"<<std::endl;
+		}
+
 		void testAllCases()
 		{
 			rbtree_test();
@@ -321,6 +1381,20 @@ namespace MINI_STL
 			hashtable_test();
 			union_set_test();
 			hashset_test();
+			hash_fcn_test();
+			flat_hash_set_test();
+			flat_hash_map_test();
+			hashmap_test();
+			hash_multiset_test();
+			hash_multimap_test();
+			segmented_vector_test();
+			concurrent_vector_test();
+			spsc_queue_test();
+			mpmc_queue_test();
+			concurrent_stack_test();
+			concurrent_hash_map_test();
+			intrusive_list_test();
+			intrusive_rbtree_test();
 		}
 	}
 }
@@ -10,6 +10,9 @@
 #include <set>
 #include <string>
 #include <map>
+#include <random>
+#include <thread>
+#include <limits>
 #include "../Functional.h"
 #include "../Heap.h"
 #include "../Slist.h"
@@ -22,7 +25,20 @@
 #include "../HashTable.h"
 #include "../Hash_fcn.h"
 #include "../Hashset.h"
+#include "../Hashmap.h"
+#include "../Hash_multiset.h"
+#include "../Hash_multimap.h"
+#include "../Flat_hash_set.h"
+#include "../Flat_hash_map.h"
 #include "../Union_set.H"
+#include "../Segmented_vector.h"
+#include "../Concurrent_vector.h"
+#include "../Spsc_queue.h"
+#include "../Mpmc_queue.h"
+#include "../Concurrent_stack.h"
+#include "../Concurrent_hash_map.h"
+#include "../Intrusive_list.h"
+#include "../Intrusive_rbtree.h"
 #include "TestUtil.h"
 
 namespace MINI_STL{
@@ -37,7 +53,21 @@ namespace MINI_STL{
 		void multimap_test();
 		void hashtable_test();
 		void hashset_test();
+		void hash_fcn_test();
+		void flat_hash_set_test();
+		void flat_hash_map_test();
+		void hashmap_test();
+		void hash_multiset_test();
+		void hash_multimap_test();
 		void union_set_test();
+		void segmented_vector_test();
+		void concurrent_vector_test();
+		void spsc_queue_test();
+		void mpmc_queue_test();
+		void concurrent_stack_test();
+		void concurrent_hash_map_test();
+		void intrusive_list_test();
+		void intrusive_rbtree_test();
 		void testAllCases();
 
 	}
@@ -0,0 +1,124 @@
+#include "CircularBufferTest.h"
+
+namespace MINI_STL{
+	namespace CircularBufferTest{
+		void testCase1(){
+			stdDQ<int> dq;
+			tsCB<int> cb;
+			assert(cb.empty() && cb.capacity() == 0);
+			for (auto i = 0; i != 100; ++i){
+				dq.push_back(i);
+				cb.push_back(i);
+				if (i % 3 == 0){
+					dq.pop_front();
+					cb.pop_front();
+				}
+			}
+			assert(MINI_STL::Test::container_equal(dq, cb));
+			for (auto i = 0; i != 50; ++i){
+				dq.push_front(i);
+				cb.push_front(i);
+			}
+			dq.pop_back();
+			cb.pop_back();
+			assert(MINI_STL::Test::container_equal(dq, cb));
+			assert(cb.front() == dq.front() && cb.back() == dq.back());
+			assert(cb[10] == dq[10] && *(cb.begin() + 70) == dq[70]);
+			assert(cb.end() - cb.begin() == (ptrdiff_t)dq.size());
+		}
+
+		void testCase2(){
+			tsCB<std::string> cb(8);
+			assert(cb.capacity() == 8);
+			for (auto i = 0; i != 1000; ++i){
+				cb.push_back(std::string(i % 10 + 1, 'a'));
+				if (cb.size() > 5)
+					cb.pop_front();
+			}
+			//容量稳定后不再扩容
+			assert(cb.capacity() == 8 && cb.size() == 5);
+			assert(cb.back() == std::string(10, 'a'));
+
+			tsCB<std::string> cb2(cb);
+			assert(cb2 == cb);
+			cb2.pop_back();
+			assert(cb2 != cb && cb2 < cb);
+			cb2 = cb;
+			assert(cb2 == cb);
+			cb.clear();
+			assert(cb.empty() && cb.capacity() == 8);
+		}
+
+		void testCase3(){
+			//overwrite模式:只保留最近的4个元素
+			tsCB<int> cb(4, true);
+			for (auto i = 0; i != 10; ++i)
+				cb.push_back(i);
+			assert(cb.full() && cb.capacity() == 4);
+			assert(cb.front() == 6 && cb.back() == 9);
+			int expect = 6;
+			for (auto it = cb.begin(); it != cb.end(); ++it)
+				assert(*it == expect++);
+			cb.pop_front();
+			cb.push_back(10);
+			cb.push_back(11);
+			assert(cb.front() == 8 && cb.back() == 11 && cb.size() == 4);
+		}
+
+		void testCase4(){
+			MINI_STL::queue<int, tsCB<int>> q;
+			for (auto i = 0; i != 100; ++i)
+				q.push(i);
+			for (auto i = 0; i != 50; ++i)
+				q.pop();
+			assert(q.size() == 50 && q.front() == 50 && q.back() == 99);
+
+			MINI_STL::stack<std::string, tsCB<std::string>> st;
+			st.push("one");
+			st.push("two");
+			assert(st.top() == "two");
+			st.pop();
+			assert(st.top() == "one" && st.size() == 1);
+		}
+
+		void testCase5(){
+			tsCB<int> cb1, cb2;
+			cb1.push_back(1); cb1.push_back(2); cb1.push_back(3);
+			cb2.push_back(1); cb2.push_back(2);
+			cb1.swap(cb2);
+			assert(cb1.size() == 2 && cb2.size() == 3);
+			assert(cb2.back() == 3);
+		}
+
+		void testCase6(){
+			//扩容时插入的值引用本容器中的元素
+			const std::string a(40, 'a'), b(40, 'b');
+			tsCB<std::string> cb(2);
+			cb.push_back(a);
+			cb.push_back(b);
+			cb.push_back(cb.front());
+			assert(cb.size() == 3 && cb.back() == a && cb.front() == a);
+			tsCB<std::string> cb2(2);
+			cb2.push_back(a);
+			cb2.push_back(b);
+			cb2.push_front(cb2.back());
+			assert(cb2.size() == 3 && cb2.front() == b && cb2.back() == b);
+
+			//overwrite模式下容量为0时按1处理,仍然不扩容
+			tsCB<int> cb3(0, true);
+			cb3.push_back(1);
+			cb3.push_back(2);
+			assert(cb3.capacity() == 1 && cb3.size() == 1 && cb3.front() == 2);
+		}
+
+		void testAllCases(){
+			testCase1();
+			testCase2();
+			testCase3();
+			testCase4();
+			testCase5();
+			testCase6();
+			std::cout<<"CircularBuffer test ok!"<<std::endl;
+		}
+	}
+}
\ No newline at end of file
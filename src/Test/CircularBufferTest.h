@@ -0,0 +1,30 @@
+#ifndef _CIRCULAR_BUFFER_TEST_H_
+#define _CIRCULAR_BUFFER_TEST_H_
+
+#include "TestUtil.h"
+
+#include "../Circular_buffer.h"
+#include "../Queue.h"
+#include "../Stack.h"
+#include <deque>
+
+#include <cassert>
+#include <string>
+
+namespace MINI_STL{
+	namespace CircularBufferTest{
+#define  stdDQ std::deque
+#define  tsCB  MINI_STL::circular_buffer
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testCase4();
+		void testCase5();
+		void testCase6();
+
+		void testAllCases();
+	}
+}
+
+#endif
\ No newline at end of file
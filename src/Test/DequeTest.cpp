@@ -91,6 +91,122 @@ namespace MINI_STL{
 			assert(foo2 == bar);
 		}
 
+		void testCase7(){
+			stdDQ<int> dq1;
+			tsDQ<int, 4096> dq2;
+			for (auto i = 0; i != 5000; ++i){
+				dq1.push_back(i);
+				dq2.push_back(i);
+				dq1.push_front(i);
+				dq2.push_front(i);
+			}
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+
+			for (auto i = 0; i != 100000; ++i){
+				dq1.push_back(i);
+				dq2.push_back(i);
+				dq1.pop_front();
+				dq2.pop_front();
+			}
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+
+			tsDQ<std::string, 64> dq3(100, "zh");
+			dq3.clear();
+			dq3.push_back("mini");
+			assert(dq3.size() == 1 && dq3.front() == "mini");
+		}
+
+		void testCase8(){
+			stdDQ<int> dq1;
+			tsDQ<int> dq2;
+			for (auto i = 0; i != 1000; ++i){
+				dq1.push_back(i);
+				dq2.push_back(i);
+			}
+			tsDQ<int> dq3(1000, 0);
+			MINI_STL::copy(dq2.begin() + 3, dq2.end() - 5, dq3.begin() + 1);
+			std::copy(dq1.begin() + 3, dq1.end() - 5, dq1.begin() + 1);
+			dq2.swap(dq3);
+			for (auto i = 0; i != 1000; ++i){
+				if (i == 0 || i >= 993)
+					dq2[i] = dq1[i];
+			}
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+
+			MINI_STL::fill(dq2.begin() + 100, dq2.begin() + 900, -1);
+			std::fill(dq1.begin() + 100, dq1.begin() + 900, -1);
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+
+			assert(*MINI_STL::find(dq2.begin(), dq2.end(), 990) == 990);
+			assert(MINI_STL::find(dq2.begin() + 1, dq2.end(), 1) == dq2.end());
+			assert(MINI_STL::find(dq2.begin(), dq2.end(), -1) - dq2.begin() == 100);
+
+			int arr[300];
+			for (auto i = 0; i != 300; ++i)
+				arr[i] = i * 2;
+			MINI_STL::copy(arr, arr + 300, dq2.begin() + 50);
+			std::copy(arr, arr + 300, dq1.begin() + 50);
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+
+			tsDQ<std::string, 64> dq4;
+			for (auto i = 0; i != 200; ++i)
+				dq4.push_back(std::string(i % 7 + 1, 'a' + i % 26));
+			tsDQ<std::string, 64> dq5(dq4);
+			assert(MINI_STL::Test::container_equal(dq4, dq5));
+			dq5.erase(dq5.begin() + 150, dq5.begin() + 190);
+			dq4.erase(dq4.begin() + 150, dq4.begin() + 190);
+			assert(MINI_STL::Test::container_equal(dq4, dq5));
+
+			tsDQ<char> dq6(2000, 'a');
+			dq6[1500] = 'b';
+			assert(MINI_STL::find(dq6.begin(), dq6.end(), 'b') - dq6.begin() == 1500);
+		}
+
+		void testCase9(){
+			stdDQ<std::string> dq1;
+			tsDQ<std::string, 64> dq2;
+			std::string arr[300];
+			for (auto i = 0; i != 300; ++i)
+				arr[i] = std::string(i % 5 + 1, 'a' + i % 26);
+
+			dq1.insert(dq1.end(), arr, arr + 100);
+			dq2.append(arr, arr + 100);
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+			dq1.insert(dq1.begin(), arr + 100, arr + 300);
+			dq2.prepend(arr + 100, arr + 300);
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+
+			//靠前/靠后,插入数多于/少于需移动的元素
+			const int pos[] = { 3, 50, 250, 290 };
+			const int len[] = { 2, 120, 7, 150 };
+			for (auto i = 0; i != 4; ++i){
+				dq1.insert(dq1.begin() + pos[i], arr, arr + len[i]);
+				auto it = dq2.insert(dq2.begin() + pos[i], arr, arr + len[i]);
+				assert(it - dq2.begin() == pos[i] && *it == arr[0]);
+				assert(MINI_STL::Test::container_equal(dq1, dq2));
+			}
+
+			MINI_STL::list<std::string> l(arr, arr + 30);
+			dq1.insert(dq1.begin() + 10, arr, arr + 30);
+			dq2.insert(dq2.begin() + 10, l.begin(), l.end());
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+
+			for (auto i = 0; i != 130; ++i){
+				dq1.pop_front();
+				dq1.pop_back();
+			}
+			dq2.pop_front_n(130);
+			dq2.pop_back_n(130);
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+
+			dq1.erase(dq1.begin() + 20, dq1.begin() + 90);
+			dq2.erase(dq2.begin() + 20, dq2.begin() + 90);
+			assert(MINI_STL::Test::container_equal(dq1, dq2));
+			dq2.pop_back_n(dq2.size());
+			assert(dq2.empty());
+			dq2.append(arr, arr + 3);
+			assert(dq2.size() == 3 && dq2.back() == arr[2]);
+		}
 
 		void testAllCases(){
 			testCase1();
@@ -99,6 +215,9 @@ namespace MINI_STL{
 			testCase4();
 			testCase5();
 			testCase6();
+			testCase7();
+			testCase8();
+			testCase9();
 			std::cout<<"Deque test ok!"<<std::endl;
 		}
 	}
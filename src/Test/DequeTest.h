@@ -4,6 +4,7 @@
 #include "TestUtil.h"
 
 #include "../Deque.h"
+#include "../List.h"
 #include <deque>
 
 #include <cassert>
@@ -21,6 +22,9 @@ namespace MINI_STL{
 		void testCase4();
 		void testCase5();
 		void testCase6();
+		void testCase7();
+		void testCase8();
+		void testCase9();
 
 		void testAllCases();
 	}
@@ -220,7 +220,77 @@ namespace MINI_STL{
 			assert(l1 == l3);
 			assert(l1 != l2);
 		}
+		void testCase16(){
+			//稳定性:只按first排序,second记录原顺序
+			typedef std::pair<int, int> P;
+			auto comp = [](const P& a, const P& b){ return a.first < b.first; };
+			std::mt19937 gen(16);
+			//有序段、逆序段、随机数据,以及超过指针数组阈值的长链表
+			int sizes[] = { 2, 3, 100, 1000, (1 << 20) + 3 };
+			for (auto n : sizes){
+				for (auto shape = 0; shape != 3; ++shape){
+					stdL<P> l1;
+					tsL<P> l2;
+					for (auto i = 0; i != n; ++i){
+						int key = shape == 0 ? i / 3 : (shape == 1 ? (n - i) / 3 : int(gen() % 50));
+						l1.push_back(P(key, i));
+						l2.push_back(P(key, i));
+					}
+					l1.sort(comp);
+					l2.sort(comp);
+					assert(MINI_STL::Test::container_equal(l1, l2));
+					auto it = l2.end();
+					assert((--it)->second == l1.back().second);
+				}
+			}
+		}
+
+
+		void testCase17(){
+			stdL<std::string> l1;
+			tsL<std::string> l2;
+			l2.set_node_cache_limit(8);
+			for (auto i = 0; i != 100; ++i){
+				l1.push_back(std::to_string(i));
+				l2.push_back(std::to_string(i));
+				if (i % 3 == 0){
+					l1.pop_front();
+					l2.pop_front();
+				}
+			}
+			assert(MINI_STL::Test::container_equal(l1, l2));
+			assert(l2.cached_nodes() <= 8);
+			l2.clear();
+			assert(l2.cached_nodes() == 8);
+			l2.push_back("reuse");
+			assert(l2.cached_nodes() == 7 && l2.front() == "reuse");
+			l2.set_node_cache_limit(0);
+			assert(l2.cached_nodes() == 0);
+
+			//摘下结点移到另一个链表,不重新分配
+			tsL<std::string> l3, l4;
+			l3.push_back("a");
+			l3.push_back("b");
+			l3.push_back("c");
+			auto it = l3.begin();
+			++it;
+			std::string* addr = &*it;
+			auto nh = l3.extract(it);
+			assert(!nh.empty() && nh.value() == "b");
+			assert(l3.size() == 2 && l3.back() == "c");
+			nh.value() = "B";
+			auto pos = l4.insert(l4.end(), std::move(nh));
+			assert(nh.empty() && &*pos == addr && l4.front() == "B");
 
+			//未链入的handle析构时释放结点
+			{
+				auto nh2 = l3.extract(l3.begin());
+				assert(nh2.value() == "a");
+			}
+			assert(l3.size() == 1 && l3.front() == "c");
+			l3.insert(l3.begin(), tsL<std::string>::node_type());
+			assert(l3.size() == 1);
+		}
 
 		void testAllCases(){
 			testCase1();
@@ -238,6 +308,8 @@ namespace MINI_STL{
 			testCase13();
 			testCase14();
 			testCase15();
+			testCase16();
+			testCase17();
 			std::cout<<"List test ok!"<<std::endl;
 		}
 	}
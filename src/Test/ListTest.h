@@ -31,6 +31,8 @@ namespace MINI_STL{
 		void testCase13();
 		void testCase14();
 		void testCase15();
+		void testCase16();
+		void testCase17();
 
 		void testAllCases();
 	}
@@ -0,0 +1,1122 @@
+#include "PerformanceTest.h"
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace MINI_STL{
+	namespace PerformanceTest{
+		using MINI_STL::Profiler::ProfilerInstance;
+
+		//打印一次计时结果
+		static void dump(const std::string& name){
+			std::cout << name << ": ";
+			ProfilerInstance::dumpDuringTime();
+		}
+
+		void vector_append_test(){
+			const int N = 1000000;
+			MINI_STL::list<int> l;
+			MINI_STL::deque<int> d;
+			int *arr = new int[N];
+			for (int i = 0; i != N; ++i){
+				l.push_back(i);
+				d.push_back(i);
+				arr[i] = i;
+			}
+
+			{
+				ProfilerInstance::start();
+				MINI_STL::vector<int> v;
+				for (auto it = l.begin(); it != l.end(); ++it)
+					v.push_back(*it);
+				ProfilerInstance::finish();
+				dump("vector push_back from list");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::vector<int> v;
+				v.append(l.begin(), l.end());
+				ProfilerInstance::finish();
+				dump("vector append from list");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::vector<int> v;
+				for (auto it = d.begin(); it != d.end(); ++it)
+					v.push_back(*it);
+				ProfilerInstance::finish();
+				dump("vector push_back from deque");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::vector<int> v;
+				v.append(d.begin(), d.end());
+				ProfilerInstance::finish();
+				dump("vector append from deque");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::vector<int> v;
+				for (int i = 0; i != N; ++i)
+					v.push_back(arr[i]);
+				ProfilerInstance::finish();
+				dump("vector push_back from pointer");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::vector<int> v;
+				v.append(arr, arr + N);
+				ProfilerInstance::finish();
+				dump("vector append from pointer");
+			}
+			delete[] arr;
+		}
+
+		//启动n个线程执行同一任务并计时
+		template<class Func>
+		static void run_threads(int n, Func f){
+			std::vector<std::thread> threads;
+			ProfilerInstance::start();
+			for (int i = 0; i != n; ++i)
+				threads.push_back(std::thread(f));
+			for (int i = 0; i != n; ++i)
+				threads[i].join();
+			ProfilerInstance::finish();
+		}
+
+		void concurrent_vector_test(){
+			const int N = 4000000;
+			const int thread_nums[] = { 1, 2, 4, 8 };
+			for (int t = 0; t != 4; ++t){
+				const int n = thread_nums[t];
+				const int per_thread = N / n;
+				std::cout << n << " threads" << std::endl;
+				{
+					MINI_STL::vector<int> v;
+					std::mutex mtx;
+					run_threads(n, [&](){
+						for (int i = 0; i != per_thread; ++i){
+							std::lock_guard<std::mutex> lock(mtx);
+							v.push_back(i);
+						}
+					});
+					dump("  mutex vector push_back");
+				}
+				{
+					MINI_STL::concurrent_vector<int> v;
+					run_threads(n, [&](){
+						for (int i = 0; i != per_thread; ++i)
+							v.push_back(i);
+					});
+					dump("  concurrent_vector push_back");
+				}
+			}
+		}
+
+		//64字节消息
+		struct Message{
+			char data[64];
+		};
+
+		template<class Queue>
+		static void queue_throughput(Queue& q, const std::string& name){
+			const int N = 10000000;
+			const int backlog = 1000;
+			Message msg;
+			ProfilerInstance::start();
+			for (int i = 0; i != backlog; ++i)
+				q.push(msg);
+			for (int i = 0; i != N; ++i){
+				q.push(msg);
+				q.pop();
+			}
+			ProfilerInstance::finish();
+			dump(name);
+		}
+
+		void queue_block_size_test(){
+			{
+				MINI_STL::queue<Message> q;
+				queue_throughput(q, "queue push/pop, 512B blocks");
+			}
+			{
+				MINI_STL::queue<Message, MINI_STL::deque<Message, 4096>> q;
+				queue_throughput(q, "queue push/pop, 4KB blocks");
+			}
+			{
+				MINI_STL::queue<Message, MINI_STL::deque<Message, 65536>> q;
+				queue_throughput(q, "queue push/pop, 64KB blocks");
+			}
+		}
+
+		//逐元素经deque_iterator处理与逐块处理的对比
+		void deque_algorithm_test(){
+			const int N = 100000000;
+			MINI_STL::deque<int> d(N, 0);
+			const MINI_STL::deque<int>::iterator mid = d.begin() + N / 2;
+			{
+				ProfilerInstance::start();
+				for (auto it = d.begin(); it != d.end(); ++it)
+					*it = 1;
+				ProfilerInstance::finish();
+				dump("deque fill, element by element");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::fill(d.begin(), d.end(), 2);
+				ProfilerInstance::finish();
+				dump("deque fill, block by block");
+			}
+			d.back() = 3;
+			MINI_STL::deque<int>::iterator found1, found2;
+			{
+				ProfilerInstance::start();
+				found1 = d.begin();
+				while (found1 != d.end() && *found1 != 3)
+					++found1;
+				ProfilerInstance::finish();
+				dump("deque find, element by element");
+			}
+			{
+				ProfilerInstance::start();
+				found2 = MINI_STL::find(d.begin(), d.end(), 3);
+				ProfilerInstance::finish();
+				dump("deque find, block by block");
+			}
+			if (found1 != found2)
+				std::cout << "deque find mismatch" << std::endl;
+			{
+				ProfilerInstance::start();
+				auto dest = mid;
+				for (auto it = d.begin(); it != mid; ++it, ++dest)
+					*dest = *it;
+				ProfilerInstance::finish();
+				dump("deque copy, element by element");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::copy(d.begin(), mid, mid);
+				ProfilerInstance::finish();
+				dump("deque copy, block by block");
+			}
+		}
+
+		//将当前线程绑定到第cpu个核
+		static void pin_thread(int cpu){
+#if defined(_WIN32)
+			SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+#elif defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpu, &set);
+			pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+		}
+
+		//把当前线程绑定到第cpu个核,析构时恢复原来的亲和性,避免影响之后的测试
+		class pin_guard{
+		public:
+			explicit pin_guard(int cpu){
+#if defined(_WIN32)
+				old_mask = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+#elif defined(__linux__)
+				pthread_getaffinity_np(pthread_self(), sizeof(old_set), &old_set);
+				pin_thread(cpu);
+#endif
+			}
+			~pin_guard(){
+#if defined(_WIN32)
+				if (old_mask)
+					SetThreadAffinityMask(GetCurrentThread(), old_mask);
+#elif defined(__linux__)
+				pthread_setaffinity_np(pthread_self(), sizeof(old_set), &old_set);
+#endif
+			}
+		private:
+#if defined(_WIN32)
+			DWORD_PTR old_mask;
+#elif defined(__linux__)
+			cpu_set_t old_set;
+#endif
+			pin_guard(const pin_guard&);
+			pin_guard& operator=(const pin_guard&);
+		};
+
+		void spsc_queue_test(){
+			const int N = 10000000;
+			const int R = 1000000;
+			//主线程作消费者绑定到1号核,生产者绑定到0号核
+			pin_guard pin(1);
+			{
+				MINI_STL::queue<int> q;
+				std::mutex mtx;
+				ProfilerInstance::start();
+				std::thread producer([&](){
+					pin_thread(0);
+					for (int i = 0; i != N; ++i){
+						std::lock_guard<std::mutex> lock(mtx);
+						q.push(i);
+					}
+				});
+				for (int n = 0; n != N;){
+					std::lock_guard<std::mutex> lock(mtx);
+					if (!q.empty()){
+						q.pop();
+						++n;
+					}
+				}
+				producer.join();
+				ProfilerInstance::finish();
+				dump("mutex queue throughput");
+			}
+			{
+				MINI_STL::spsc_queue<int> q(4096);
+				ProfilerInstance::start();
+				std::thread producer([&](){
+					pin_thread(0);
+					for (int i = 0; i != N; ++i)
+						q.push(i);
+				});
+				int value;
+				for (int n = 0; n != N;){
+					if (q.try_pop(value))
+						++n;
+				}
+				producer.join();
+				ProfilerInstance::finish();
+				dump("spsc_queue throughput");
+			}
+			{
+				MINI_STL::spsc_queue<int> q(4096);
+				ProfilerInstance::start();
+				std::thread producer([&](){
+					pin_thread(0);
+					int buf[64];
+					for (int i = 0; i != N;){
+						const int n = MINI_STL::min(64, N - i);
+						for (int k = 0; k != n; ++k)
+							buf[k] = i + k;
+						for (int k = 0; k != n;)
+							k += (int)q.push_n(buf + k, n - k);
+						i += n;
+					}
+				});
+				int buf[64];
+				for (int n = 0; n != N;)
+					n += (int)q.pop_n(buf, 64);
+				producer.join();
+				ProfilerInstance::finish();
+				dump("spsc_queue push_n/pop_n throughput");
+			}
+			{
+				//两个队列来回传递一个值,总时间/R即单程延迟的2倍
+				MINI_STL::spsc_queue<int> ping(64), pong(64);
+				ProfilerInstance::start();
+				std::thread echo([&](){
+					pin_thread(0);
+					int value;
+					for (int i = 0; i != R; ++i){
+						while (!ping.try_pop(value))
+							;
+						pong.push(value);
+					}
+				});
+				int value;
+				for (int i = 0; i != R; ++i){
+					ping.push(i);
+					while (!pong.try_pop(value))
+						;
+				}
+				echo.join();
+				ProfilerInstance::finish();
+				std::cout << R << " round trips, ";
+				dump("spsc_queue latency");
+			}
+		}
+
+		//n个生产者与n个消费者共传递N个元素
+		void mpmc_queue_test(){
+			const int N = 4000000;
+			const int thread_nums[] = { 1, 2, 4, 8, 16 };
+			for (int t = 0; t != 5; ++t){
+				const int n = thread_nums[t];
+				const int per_thread = N / n;
+				std::cout << n << " producers, " << n << " consumers" << std::endl;
+				{
+					MINI_STL::queue<int, MINI_STL::deque<int>> q;
+					std::mutex mtx;
+					std::atomic<int> ids(0);
+					run_threads(2 * n, [&](){
+						if (ids++ % 2 == 0){
+							for (int i = 0; i != per_thread; ++i){
+								std::lock_guard<std::mutex> lock(mtx);
+								q.push(i);
+							}
+						}
+						else{
+							for (int i = 0; i != per_thread;){
+								std::lock_guard<std::mutex> lock(mtx);
+								if (!q.empty()){
+									q.pop();
+									++i;
+								}
+							}
+						}
+					});
+					dump("  mutex queue");
+				}
+				{
+					MINI_STL::mpmc_queue<int> q(4096);
+					std::atomic<int> ids(0);
+					run_threads(2 * n, [&](){
+						int value;
+						if (ids++ % 2 == 0){
+							for (int i = 0; i != per_thread; ++i)
+								q.push(i);
+						}
+						else{
+							for (int i = 0; i != per_thread; ++i)
+								q.pop(value);
+						}
+					});
+					dump("  mpmc_queue");
+				}
+				{
+					MINI_STL::mpmc_queue<int> q(4096);
+					std::atomic<int> ids(0);
+					run_threads(2 * n, [&](){
+						int buf[32];
+						if (ids++ % 2 == 0){
+							for (int k = 0; k != 32; ++k)
+								buf[k] = k;
+							for (int i = 0; i != per_thread;){
+								const int m = (int)q.push_n(buf, MINI_STL::min(32, per_thread - i));
+								if (m == 0)
+									std::this_thread::yield();
+								i += m;
+							}
+						}
+						else{
+							for (int i = 0; i != per_thread;){
+								const int m = (int)q.pop_n(buf, MINI_STL::min(32, per_thread - i));
+								if (m == 0)
+									std::this_thread::yield();
+								i += m;
+							}
+						}
+					});
+					dump("  mpmc_queue push_n/pop_n");
+				}
+			}
+		}
+
+		//每个线程交替push/pop,栈顶竞争随线程数增加
+		void concurrent_stack_test(){
+			const int N = 4000000;
+			const int thread_nums[] = { 1, 2, 4, 8 };
+			for (int t = 0; t != 4; ++t){
+				const int n = thread_nums[t];
+				const int per_thread = N / n;
+				std::cout << n << " threads" << std::endl;
+				{
+					MINI_STL::stack<int> st;
+					std::mutex mtx;
+					run_threads(n, [&](){
+						for (int i = 0; i != per_thread; ++i){
+							{
+								std::lock_guard<std::mutex> lock(mtx);
+								st.push(i);
+							}
+							std::lock_guard<std::mutex> lock(mtx);
+							st.pop();
+						}
+					});
+					dump("  mutex stack push/pop");
+				}
+				{
+					MINI_STL::concurrent_stack<int> st;
+					run_threads(n, [&](){
+						int value;
+						for (int i = 0; i != per_thread; ++i){
+							st.push(i);
+							st.try_pop(value);
+						}
+					});
+					dump("  concurrent_stack push/pop");
+				}
+			}
+		}
+
+		//容量稳定后circular_buffer不再申请内存;deque靠spare_nodes复用最多4个缓冲区,也基本不再申请内存,差别主要在跨缓冲区时维护map与节点指针的开销
+		void circular_buffer_test(){
+			{
+				MINI_STL::queue<Message> q;
+				queue_throughput(q, "queue push/pop, deque");
+			}
+			{
+				MINI_STL::queue<Message, MINI_STL::circular_buffer<Message>> q;
+				queue_throughput(q, "queue push/pop, circular_buffer");
+			}
+		}
+
+		//slist原地排序/去重/翻转 vs 拷贝到vector处理后再拷回
+		void slist_algorithm_test(){
+			const int N = 3000000;
+			MINI_STL::slist<int> sl1, sl2;
+			for (int i = 0; i != N; ++i){
+				int v = int((i * 2654435761u) % 1000003);
+				sl1.push_front(v);
+				sl2.push_front(v);
+			}
+			{
+				ProfilerInstance::start();
+				sl1.sort();
+				sl1.unique();
+				sl1.reverse();
+				ProfilerInstance::finish();
+				dump("slist sort/unique/reverse, in place");
+			}
+			{
+				ProfilerInstance::start();
+				std::vector<int> v;
+				v.reserve(sl2.size());
+				for (auto it = sl2.begin(); it != sl2.end(); ++it)
+					v.push_back(*it);
+				std::sort(v.begin(), v.end());
+				v.erase(std::unique(v.begin(), v.end()), v.end());
+				std::reverse(v.begin(), v.end());
+				sl2.clear();
+				for (auto it = v.begin(); it != v.end(); ++it)
+					sl2.push_back(*it);
+				ProfilerInstance::finish();
+				dump("slist sort/unique/reverse, via vector");
+			}
+			if (sl1.size() != sl2.size() || !MINI_STL::equal(sl1.begin(), sl1.end(), sl2.begin()))
+				std::cout << "slist algorithm mismatch" << std::endl;
+		}
+
+		//遍历与在同一位置反复插入:unrolled_list vs list
+		void unrolled_list_test(){
+			const int N = 10000000;
+			MINI_STL::list<int> l;
+			MINI_STL::unrolled_list<int> ul;
+			for (int i = 0; i != N; ++i){
+				l.push_back(i);
+				ul.push_back(i);
+			}
+			long long sum1 = 0, sum2 = 0;
+			{
+				ProfilerInstance::start();
+				for (auto it = l.begin(); it != l.end(); ++it)
+					sum1 += *it;
+				ProfilerInstance::finish();
+				dump("list iterate");
+			}
+			{
+				ProfilerInstance::start();
+				for (auto it = ul.begin(); it != ul.end(); ++it)
+					sum2 += *it;
+				ProfilerInstance::finish();
+				dump("unrolled_list iterate");
+			}
+			if (sum1 != sum2)
+				std::cout << "unrolled_list iterate mismatch" << std::endl;
+
+			const int M = 1000000;
+			auto lit = l.begin();
+			auto ulit = ul.begin();
+			for (int i = 0; i != N / 2; ++i){
+				++lit;
+				++ulit;
+			}
+			{
+				ProfilerInstance::start();
+				for (int i = 0; i != M; ++i)
+					lit = l.insert(lit, i);
+				ProfilerInstance::finish();
+				dump("list insert in the middle");
+			}
+			{
+				ProfilerInstance::start();
+				for (int i = 0; i != M; ++i)
+					ulit = ul.insert(ulit, i);
+				ProfilerInstance::finish();
+				dump("unrolled_list insert in the middle");
+			}
+		}
+
+		//list::sort在1K~100M个结点上的耗时,随机数据与已有序数据,以std::list::sort为参照
+		void list_sort_test(){
+			for (int n = 1000; n <= 100000000; n *= 10){
+				std::cout << n << " nodes" << std::endl;
+				{
+					std::mt19937 gen(n);
+					MINI_STL::list<int> l;
+					for (int i = 0; i != n; ++i)
+						l.push_back(int(gen()));
+					ProfilerInstance::start();
+					l.sort();
+					ProfilerInstance::finish();
+					dump("  list sort, random");
+				}
+				{
+					std::mt19937 gen(n);
+					std::list<int> l;
+					for (int i = 0; i != n; ++i)
+						l.push_back(int(gen()));
+					ProfilerInstance::start();
+					l.sort();
+					ProfilerInstance::finish();
+					dump("  std::list sort, random");
+				}
+				{
+					MINI_STL::list<int> l;
+					for (int i = 0; i != n; ++i)
+						l.push_back(i);
+					ProfilerInstance::start();
+					l.sort();
+					ProfilerInstance::finish();
+					dump("  list sort, sorted");
+				}
+			}
+		}
+
+		struct pooled_object{
+			int key;
+			MINI_STL::intrusive_list_hook list_hook;
+			MINI_STL::intrusive_rbtree_hook tree_hook;
+			bool operator<(const pooled_object& x)const{ return key < x.key; }
+		};
+
+		//对象已在池中时,侵入式容器只改指针;list/multiset每次插入都要分配结点并拷贝
+		void intrusive_test(){
+			const int N = 1000000;
+			std::vector<pooled_object> pool(N);
+			for (int i = 0; i != N; ++i)
+				pool[i].key = int((i * 2654435761u) % N);
+			{
+				ProfilerInstance::start();
+				MINI_STL::list<pooled_object> l;
+				for (int i = 0; i != N; ++i)
+					l.push_back(pool[i]);
+				while (!l.empty())
+					l.pop_front();
+				ProfilerInstance::finish();
+				dump("list push_back/pop_front");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::intrusive_list<pooled_object, &pooled_object::list_hook> l;
+				for (int i = 0; i != N; ++i)
+					l.push_back(pool[i]);
+				while (!l.empty())
+					l.pop_front();
+				ProfilerInstance::finish();
+				dump("intrusive_list push_back/pop_front");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::multiset<pooled_object> ms;
+				for (int i = 0; i != N; ++i)
+					ms.insert(pool[i]);
+				for (int i = 0; i != N; ++i)
+					ms.erase(ms.find(pool[i]));
+				ProfilerInstance::finish();
+				dump("multiset insert/erase");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::intrusive_rbtree<pooled_object, &pooled_object::tree_hook> t;
+				for (int i = 0; i != N; ++i)
+					t.insert_equal(pool[i]);
+				for (int i = 0; i != N; ++i)
+					t.remove(pool[i]);
+				ProfilerInstance::finish();
+				dump("intrusive_rbtree insert/erase");
+			}
+		}
+
+		//LRU式的反复push_back/erase:默认list、开启结点缓存、用extract/insert移动结点
+		void list_churn_test(){
+			const int N = 10000000;
+			const int live = 1000;
+			{
+				MINI_STL::list<std::string> l;
+				for (int i = 0; i != live; ++i)
+					l.push_back("value");
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i){
+					l.erase(l.begin());
+					l.push_back("value");
+				}
+				ProfilerInstance::finish();
+				dump("list erase/push_back");
+			}
+			{
+				MINI_STL::list<std::string> l;
+				l.set_node_cache_limit(64);
+				for (int i = 0; i != live; ++i)
+					l.push_back("value");
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i){
+					l.erase(l.begin());
+					l.push_back("value");
+				}
+				ProfilerInstance::finish();
+				dump("list erase/push_back, node cache");
+			}
+			{
+				MINI_STL::list<std::string> l;
+				for (int i = 0; i != live; ++i)
+					l.push_back("value");
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i)
+					l.insert(l.end(), l.extract(l.begin()));
+				ProfilerInstance::finish();
+				dump("list extract/insert");
+			}
+		}
+
+		//依次计时插入、命中查找、未命中查找、删除
+		//查找和删除用另一个随机顺序,避免链式结点按插入顺序分配而被顺序访问
+		template<class Set>
+		static void hash_set_phases(const std::string& name, const std::vector<int>& keys, const std::vector<int>& probes){
+			Set s;
+			size_t found = 0;
+			ProfilerInstance::start();
+			for (size_t i = 0; i != keys.size(); ++i)
+				s.insert(keys[i]);
+			ProfilerInstance::finish();
+			dump(name + " insert");
+			ProfilerInstance::start();
+			for (size_t i = 0; i != keys.size(); ++i)
+				found += s.find(probes[i]) != s.end();
+			ProfilerInstance::finish();
+			dump(name + " find hit");
+			ProfilerInstance::start();
+			for (size_t i = 0; i != keys.size(); ++i)
+				found += s.find(probes[i] + 1) != s.end();
+			ProfilerInstance::finish();
+			dump(name + " find miss");
+			ProfilerInstance::start();
+			for (size_t i = 0; i != keys.size(); ++i)
+				s.erase(probes[i]);
+			ProfilerInstance::finish();
+			dump(name + " erase");
+			if (found != keys.size() || !s.empty())
+				std::cout << name << " wrong result" << std::endl;
+		}
+
+		//链式hashset与开放寻址flat_hash_set,键为互不相同的偶数
+		void flat_hash_test(){
+			for (int N = 1000; N <= 10000000; N *= 100){
+				std::vector<int> keys(N);
+				for (int i = 0; i != N; ++i)
+					keys[i] = 2 * i;
+				std::shuffle(keys.begin(), keys.end(), std::mt19937(N));
+				std::vector<int> probes(keys);
+				std::shuffle(probes.begin(), probes.end(), std::mt19937(N + 1));
+				std::cout << "N = " << N << std::endl;
+				hash_set_phases<MINI_STL::hashset<int>>("hashset", keys, probes);
+				hash_set_phases<MINI_STL::flat_hash_set<int>>("flat_hash_set", keys, probes);
+			}
+		}
+
+		//整数键hashset:质数桶数取模与2的幂桶数按位与
+		//连续的键在恒等哈希取模下恰好一桶一个,是质数策略的最好情况,这里另外测随机键
+		void hash_bucket_policy_test(){
+			typedef MINI_STL::hashset<int, MINI_STL::hash<int>, MINI_STL::equal_to<int>, MINI_STL::prime_bucket_policy> prime_set;
+			typedef MINI_STL::hashset<int, MINI_STL::hash<int>, MINI_STL::equal_to<int>, MINI_STL::pow2_bucket_policy> pow2_set;
+			for (int N = 1000; N <= 10000000; N *= 100){
+				std::mt19937 rng(N);
+				std::vector<int> keys(N);
+				for (int i = 0; i != N; ++i)
+					keys[i] = 2 * i;
+				std::shuffle(keys.begin(), keys.end(), rng);
+				std::vector<int> probes(keys);
+				std::shuffle(probes.begin(), probes.end(), rng);
+				std::cout << "N = " << N << ", sequential keys" << std::endl;
+				hash_set_phases<prime_set>("hashset prime %", keys, probes);
+				hash_set_phases<pow2_set>("hashset pow2 mask", keys, probes);
+
+				//随机的偶数键,去重后再打乱
+				for (int i = 0; i != N; ++i)
+					keys[i] = int(rng() & 0x7ffffffe);
+				std::sort(keys.begin(), keys.end());
+				keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+				std::shuffle(keys.begin(), keys.end(), rng);
+				probes = keys;
+				std::shuffle(probes.begin(), probes.end(), rng);
+				std::cout << "N = " << keys.size() << ", random keys" << std::endl;
+				hash_set_phases<prime_set>("hashset prime %", keys, probes);
+				hash_set_phases<pow2_set>("hashset pow2 mask", keys, probes);
+			}
+		}
+
+		//原来的SGI字符串哈希,作为对照
+		static size_t sgi_hash_bytes(const char* s, size_t len){
+			unsigned long h = 0;
+			for (size_t i = 0; i != len; ++i)
+				h = 5 * h + s[i];
+			return size_t(h);
+		}
+
+		struct sgi_string_hash{
+			size_t operator()(const std::string& s) const { return sgi_hash_bytes(s.data(), s.size()); }
+		};
+
+		//字节哈希吞吐,以及URL式键在hashset中的查找
+		void hash_fcn_test(){
+			const size_t total = 256 * 1024 * 1024;
+			const size_t lens[] = { 8, 64, 1024, 65536 };
+			std::string buf(65536 + 8, 'x');
+			std::mt19937 rng(45);
+			for (size_t i = 0; i != buf.size(); ++i)
+				buf[i] = char(rng());
+			for (int k = 0; k != 4; ++k){
+				const size_t len = lens[k];
+				const size_t rounds = total / len;
+				size_t sink = 0;
+				ProfilerInstance::start();
+				for (size_t i = 0; i != rounds; ++i)
+					sink += sgi_hash_bytes(buf.data() + (i & 7), len);
+				ProfilerInstance::finish();
+				dump("sgi hash 256MB, length " + std::to_string(len));
+				ProfilerInstance::start();
+				for (size_t i = 0; i != rounds; ++i)
+					sink += MINI_STL::hash_bytes(buf.data() + (i & 7), len);
+				ProfilerInstance::finish();
+				dump("hash_bytes 256MB, length " + std::to_string(len));
+				if (sink == 42)
+					std::cout << std::endl;
+			}
+
+			const int N = 1000000;
+			std::vector<std::string> urls(N);
+			for (int i = 0; i != N; ++i)
+				urls[i] = "https://www.example.com/catalog/item?id=" + std::to_string(i) + "&ref=home";
+			std::vector<std::string> probes(urls);
+			std::shuffle(probes.begin(), probes.end(), rng);
+			{
+				MINI_STL::hashset<std::string, sgi_string_hash> s;
+				for (int i = 0; i != N; ++i)
+					s.insert(urls[i]);
+				size_t found = 0;
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i)
+					found += s.isContain(probes[i]);
+				ProfilerInstance::finish();
+				dump("hashset<string> find, sgi hash");
+				if (found != size_t(N))
+					std::cout << "wrong result" << std::endl;
+			}
+			{
+				MINI_STL::hashset<std::string> s;
+				for (int i = 0; i != N; ++i)
+					s.insert(urls[i]);
+				size_t found = 0;
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i)
+					found += s.isContain(probes[i]);
+				ProfilerInstance::finish();
+				dump("hashset<string> find, hash_bytes");
+				if (found != size_t(N))
+					std::cout << "wrong result" << std::endl;
+			}
+		}
+
+		//逐次计时插入,打印延迟分位数,看一次性重建造成的停顿
+		template<class Set>
+		static void insert_latency(const std::string& name, Set& s, const std::vector<int>& keys){
+			std::vector<double> lat(keys.size());
+			const auto begin = std::chrono::steady_clock::now();
+			for (size_t i = 0; i != keys.size(); ++i){
+				const auto t0 = std::chrono::steady_clock::now();
+				s.insert(keys[i]);
+				lat[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+			}
+			const double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+			std::sort(lat.begin(), lat.end());
+			const size_t n = lat.size();
+			std::cout << name << ": total " << total << " ms, p50 " << lat[n / 2] << " us, p99 " << lat[n * 99 / 100]
+				<< " us, p99.99 " << lat[n - n / 10000 - 1] << " us, max " << lat[n - 1] << " us" << std::endl;
+		}
+
+		void hash_incremental_rehash_test(){
+			const int N = 10000000;
+			std::vector<int> keys(N);
+			for (int i = 0; i != N; ++i)
+				keys[i] = i;
+			std::shuffle(keys.begin(), keys.end(), std::mt19937(N));
+			{
+				MINI_STL::hashset<int> s;
+				insert_latency("hashset insert, full rehash", s, keys);
+			}
+			{
+				MINI_STL::hashset<int> s;
+				s.set_incremental_rehash(true);
+				insert_latency("hashset insert, incremental rehash", s, keys);
+			}
+		}
+
+		//预留桶数组与负载因子上限:插入耗时、查找耗时与桶数
+		void hash_load_factor_test(){
+			const int N = 10000000;
+			std::vector<int> keys(N);
+			for (int i = 0; i != N; ++i)
+				keys[i] = int(i * 2654435761u);
+			std::vector<int> probes(keys);
+			std::shuffle(probes.begin(), probes.end(), std::mt19937(N));
+			//先不计时地插入一遍:内存池中结点被回收后顺序已打乱,之后各组都从同样状态的池中分配
+			{
+				MINI_STL::hashset<int> warm(N);
+				for (int i = 0; i != N; ++i)
+					warm.insert(keys[i]);
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::hashset<int> s;
+				for (int i = 0; i != N; ++i)
+					s.insert(keys[i]);
+				ProfilerInstance::finish();
+				dump("hashset insert 10M, growing");
+			}
+			{
+				ProfilerInstance::start();
+				MINI_STL::hashset<int> s(N);
+				for (int i = 0; i != N; ++i)
+					s.insert(keys[i]);
+				ProfilerInstance::finish();
+				dump("hashset insert 10M, presized");
+			}
+			const float factors[] = { 0.5f, 1.0f, 2.0f, 4.0f };
+			for (int k = 0; k != 4; ++k){
+				MINI_STL::hashset<int> s;
+				s.max_load_factor(factors[k]);
+				s.reserve(N);
+				for (int i = 0; i != N; ++i)
+					s.insert(keys[i]);
+				size_t found = 0;
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i)
+					found += s.isContain(probes[i]);
+				ProfilerInstance::finish();
+				dump("hashset find 10M, max_load_factor " + std::to_string(factors[k]) + ", " + std::to_string(s.bucket_count()) + " buckets");
+				if (found != size_t(N))
+					std::cout << "wrong result" << std::endl;
+			}
+		}
+
+		//字符串键:插入(含扩容)、显式重建、查找命中与未命中
+		template<class Set>
+		static void string_set_phases(const std::string& name, const std::vector<std::string>& keys,
+			const std::vector<std::string>& probes, const std::vector<std::string>& misses){
+			const size_t n = keys.size();
+			Set s;
+			s.max_load_factor(4.0f);
+			ProfilerInstance::start();
+			for (size_t i = 0; i != n; ++i)
+				s.insert(keys[i]);
+			ProfilerInstance::finish();
+			dump(name + " insert 1M");
+			ProfilerInstance::start();
+			s.rehash(n * 2);
+			ProfilerInstance::finish();
+			dump(name + " rehash to 2M buckets");
+			s.rehash(0);
+			size_t found = 0;
+			ProfilerInstance::start();
+			for (size_t i = 0; i != n; ++i)
+				found += s.isContain(probes[i]);
+			ProfilerInstance::finish();
+			dump(name + " find hit 1M, load factor " + std::to_string(s.load_factor()));
+			ProfilerInstance::start();
+			for (size_t i = 0; i != n; ++i)
+				found += s.isContain(misses[i]);
+			ProfilerInstance::finish();
+			dump(name + " find miss 1M");
+			if (found != n)
+				std::cout << "wrong result" << std::endl;
+		}
+
+		//结点缓存哈希值与否:URL式的长字符串键
+		void hash_cached_code_test(){
+			const int N = 1000000;
+			std::vector<std::string> keys(N), misses(N);
+			for (int i = 0; i != N; ++i){
+				keys[i] = "https://www.example.com/catalog/item?id=" + std::to_string(i) + "&ref=home";
+				misses[i] = "https://www.example.com/catalog/item?id=" + std::to_string(i) + "&ref=mail";
+			}
+			std::vector<std::string> probes(keys);
+			std::mt19937 rng(48);
+			std::shuffle(probes.begin(), probes.end(), rng);
+			std::shuffle(misses.begin(), misses.end(), rng);
+			typedef MINI_STL::hashset<std::string, MINI_STL::hash<std::string>, MINI_STL::equal_to<std::string>,
+				MINI_STL::prime_bucket_policy, false> plain_set;
+			typedef MINI_STL::hashset<std::string, MINI_STL::hash<std::string>, MINI_STL::equal_to<std::string>,
+				MINI_STL::prime_bucket_policy, true> cached_set;
+			string_set_phases<plain_set>("hashset<string>", keys, probes, misses);
+			string_set_phases<cached_set>("hashset<string> cached hash", keys, probes, misses);
+		}
+
+		//点查找:hashmap与map;按键取全部值:hash_multimap与multimap
+		void hash_map_lookup_test(){
+			const int N = 1000000;
+			std::vector<int> keys(N);
+			for (int i = 0; i != N; ++i)
+				keys[i] = int(i * 2654435761u);
+			std::vector<int> probes(keys);
+			std::shuffle(probes.begin(), probes.end(), std::mt19937(49));
+			{
+				MINI_STL::map<int, int> m;
+				for (int i = 0; i != N; ++i)
+					m[keys[i]] = i;
+				long long sum = 0;
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i)
+					sum += m.find(probes[i])->second;
+				ProfilerInstance::finish();
+				dump("map find 1M");
+				if (sum != (long long)N * (N - 1) / 2)
+					std::cout << "wrong result" << std::endl;
+			}
+			{
+				MINI_STL::hashmap<int, int> m;
+				for (int i = 0; i != N; ++i)
+					m[keys[i]] = i;
+				long long sum = 0;
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i)
+					sum += m.find(probes[i])->second;
+				ProfilerInstance::finish();
+				dump("hashmap find 1M");
+				if (sum != (long long)N * (N - 1) / 2)
+					std::cout << "wrong result" << std::endl;
+			}
+
+			//每个键4个值,按打乱的顺序取出
+			const int K = N / 4;
+			std::vector<int> multi_probes(keys.begin(), keys.begin() + K);
+			std::shuffle(multi_probes.begin(), multi_probes.end(), std::mt19937(K));
+			{
+				MINI_STL::multimap<int, int> m;
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i)
+					m.insert(MINI_STL::make_pair(keys[i % K], i));
+				ProfilerInstance::finish();
+				dump("multimap insert 1M, 4 values per key");
+				long long sum = 0;
+				ProfilerInstance::start();
+				for (int i = 0; i != K; ++i){
+					auto r = m.equal_range(multi_probes[i]);
+					for (; r.first != r.second; ++r.first)
+						sum += r.first->second;
+				}
+				ProfilerInstance::finish();
+				dump("multimap equal_range 250K");
+				if (sum != (long long)N * (N - 1) / 2)
+					std::cout << "wrong result" << std::endl;
+			}
+			{
+				MINI_STL::hash_multimap<int, int> m;
+				ProfilerInstance::start();
+				for (int i = 0; i != N; ++i)
+					m.insert(MINI_STL::make_pair(keys[i % K], i));
+				ProfilerInstance::finish();
+				dump("hash_multimap insert 1M, 4 values per key");
+				long long sum = 0;
+				ProfilerInstance::start();
+				for (int i = 0; i != K; ++i){
+					auto r = m.equal_range(multi_probes[i]);
+					for (; r.first != r.second; ++r.first)
+						sum += r.first->second;
+				}
+				ProfilerInstance::finish();
+				dump("hash_multimap equal_range 250K");
+				if (sum != (long long)N * (N - 1) / 2)
+					std::cout << "wrong result" << std::endl;
+			}
+		}
+
+		//读多写少(5%upsert,95%查找)与写多(50%upsert,50%查找)两种混合,单锁hashmap与分片concurrent_hash_map
+		void concurrent_hash_map_test(){
+			const int N = 4000000;
+			const int K = 1000000;
+			const int thread_nums[] = { 1, 2, 4, 8, 16, 32 };
+			const int write_percents[] = { 5, 50 };
+			for (int w = 0; w != 2; ++w){
+				const unsigned writes = unsigned(write_percents[w]);
+				std::cout << write_percents[w] << "% writes" << std::endl;
+				for (int t = 0; t != 6; ++t){
+					const int n = thread_nums[t];
+					const int per_thread = N / n;
+					std::cout << "  " << n << " threads" << std::endl;
+					{
+						MINI_STL::hashmap<int, int> m;
+						for (int i = 0; i != K; ++i)
+							m[i] = i;
+						std::mutex mtx;
+						std::atomic<int> seed(0);
+						run_threads(n, [&](){
+							unsigned x = unsigned(++seed) * 2654435761u;
+							for (int i = 0; i != per_thread; ++i){
+								x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+								const int key = int(x % K);
+								std::lock_guard<std::mutex> lock(mtx);
+								if (x / K % 100 < writes)
+									m[key] = i;
+								else if (m.find(key) == m.end())
+									std::cout << "wrong result" << std::endl;
+							}
+						});
+						dump("    mutex hashmap");
+					}
+					{
+						MINI_STL::concurrent_hash_map<int, int> m;
+						for (int i = 0; i != K; ++i)
+							m.insert(i, i);
+						std::atomic<int> seed(0);
+						run_threads(n, [&](){
+							unsigned x = unsigned(++seed) * 2654435761u;
+							int value;
+							for (int i = 0; i != per_thread; ++i){
+								x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+								const int key = int(x % K);
+								if (x / K % 100 < writes)
+									m.upsert(key, i);
+								else if (!m.find(key, value))
+									std::cout << "wrong result" << std::endl;
+							}
+						});
+						dump("    concurrent_hash_map");
+					}
+				}
+			}
+		}
+
+		void testAllCases(){
+			vector_append_test();
+			concurrent_vector_test();
+			queue_block_size_test();
+			deque_algorithm_test();
+			spsc_queue_test();
+			mpmc_queue_test();
+			concurrent_stack_test();
+			circular_buffer_test();
+			slist_algorithm_test();
+			unrolled_list_test();
+			list_sort_test();
+			intrusive_test();
+			list_churn_test();
+			flat_hash_test();
+			hash_bucket_policy_test();
+			hash_fcn_test();
+			hash_incremental_rehash_test();
+			hash_load_factor_test();
+			hash_cached_code_test();
+			hash_map_lookup_test();
+			concurrent_hash_map_test();
+		}
+	}
+}
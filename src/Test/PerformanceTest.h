@@ -0,0 +1,68 @@
+#ifndef _MINI_STL_PERFORMANCE_TEST_H_
+#define _MINI_STL_PERFORMANCE_TEST_H_
+
+#include "../Profiler/Profiler.h"
+#include "../Vector.h"
+#include "../List.h"
+#include "../Deque.h"
+#include "../Queue.h"
+#include "../Stack.h"
+#include "../Concurrent_vector.h"
+#include "../Spsc_queue.h"
+#include "../Mpmc_queue.h"
+#include "../Concurrent_stack.h"
+#include "../Concurrent_hash_map.h"
+#include "../Circular_buffer.h"
+#include "../Slist.h"
+#include "../Unrolled_list.h"
+#include "../Multiset.h"
+#include "../Intrusive_list.h"
+#include "../Intrusive_rbtree.h"
+#include "../Hashset.h"
+#include "../Hashmap.h"
+#include "../Hash_multimap.h"
+#include "../Map.h"
+#include "../Multimap.h"
+#include "../Flat_hash_set.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MINI_STL{
+	namespace PerformanceTest{
+
+		void vector_append_test();
+		void concurrent_vector_test();
+		void queue_block_size_test();
+		void deque_algorithm_test();
+		void spsc_queue_test();
+		void mpmc_queue_test();
+		void concurrent_stack_test();
+		void circular_buffer_test();
+		void slist_algorithm_test();
+		void unrolled_list_test();
+		void list_sort_test();
+		void intrusive_test();
+		void list_churn_test();
+		void flat_hash_test();
+		void hash_bucket_policy_test();
+		void hash_fcn_test();
+		void hash_incremental_rehash_test();
+		void hash_load_factor_test();
+		void hash_cached_code_test();
+		void hash_map_lookup_test();
+		void concurrent_hash_map_test();
+
+		void testAllCases();
+	}
+}
+
+#endif
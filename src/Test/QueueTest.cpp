@@ -55,12 +55,27 @@ namespace MINI_STL{
 			assert(q1.size() == 3 && q2.size() == 2);
 		}
 
+		void testCase6(){
+			tsQ<int> q;
+			int arr[1000];
+			for (auto i = 0; i != 1000; ++i)
+				arr[i] = i;
+			q.push(arr, arr + 1000);
+			assert(q.size() == 1000 && q.front() == 0 && q.back() == 999);
+			q.pop(600);
+			assert(q.size() == 400 && q.front() == 600);
+			q.push(arr, arr + 10);
+			q.pop(405);
+			assert(q.size() == 5 && q.front() == 5 && q.back() == 9);
+		}
+
 		void testAllCases(){
 			testCase1();
 			testCase2();
 			testCase3();
 			testCase4();
 			testCase5();
+			testCase6();
 		}
 	}
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ namespace MINI_STL{
 		void testCase3();
 		void testCase4();
 		void testCase5();
+		void testCase6();
 
 		void testAllCases();
 	}
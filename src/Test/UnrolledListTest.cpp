@@ -0,0 +1,178 @@
+#include "UnrolledListTest.h"
+
+namespace MINI_STL{
+	namespace UnrolledListTest{
+		void testCase1(){
+			int arr[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+			stdL<int> l1(std::begin(arr), std::end(arr));
+			tsUL<int> l2(std::begin(arr), std::end(arr));
+			assert(MINI_STL::Test::container_equal(l1, l2));
+			assert(l2.size() == 9 && l2.front() == 1 && l2.back() == 9);
+
+			auto l3(l2);
+			assert(l3 == l2);
+			tsUL<int> l4;
+			assert(l4.empty() && l4.size() == 0);
+			l4 = l2;
+			assert(l4 == l2);
+			l4.pop_back();
+			assert(l4 != l2);
+		}
+		void testCase2(){
+			stdL<std::string> l1;
+			tsUL<std::string, 4> l2;
+			for (auto i = 0; i != 100; ++i){
+				l1.push_front(std::to_string(i));
+				l2.push_front(std::to_string(i));
+				l1.push_back(std::to_string(i));
+				l2.push_back(std::to_string(i));
+			}
+			assert(MINI_STL::Test::container_equal(l1, l2));
+			for (auto i = 0; i != 50; ++i){
+				l1.pop_front();
+				l2.pop_front();
+				l1.pop_back();
+				l2.pop_back();
+			}
+			assert(MINI_STL::Test::container_equal(l1, l2));
+			assert(l2.size() == 100);
+
+			//反向遍历
+			auto it1 = l1.end();
+			auto it2 = l2.end();
+			while (it2 != l2.begin())
+				assert(*--it1 == *--it2);
+		}
+		void testCase3(){
+			//在同一位置反复插入,触发结点分裂
+			stdL<int> l1;
+			tsUL<int, 8> l2;
+			for (auto i = 0; i != 10; ++i){
+				l1.push_back(i);
+				l2.push_back(i);
+			}
+			auto it1 = l1.begin();
+			auto it2 = l2.begin();
+			for (auto i = 0; i != 5; ++i){
+				++it1;
+				++it2;
+			}
+			for (auto i = 0; i != 100; ++i){
+				it1 = l1.insert(it1, i);
+				it2 = l2.insert(it2, i);
+				assert(*it2 == i);
+			}
+			assert(MINI_STL::Test::container_equal(l1, l2));
+			assert(l2.size() == 110);
+
+			//删除隔一个元素,触发结点合并
+			it1 = l1.begin();
+			it2 = l2.begin();
+			while (it2 != l2.end()){
+				it1 = l1.erase(it1);
+				it2 = l2.erase(it2);
+				if (it2 != l2.end()){
+					++it1;
+					++it2;
+				}
+			}
+			assert(MINI_STL::Test::container_equal(l1, l2));
+			assert(l2.size() == 55);
+		}
+		void testCase4(){
+			stdL<int> l1;
+			tsUL<int, 4> l2;
+			for (auto i = 0; i != 100; ++i){
+				l1.push_back(i);
+				l2.push_back(i);
+			}
+			auto first1 = l1.begin(), last1 = l1.begin();
+			auto first2 = l2.begin(), last2 = l2.begin();
+			for (auto i = 0; i != 10; ++i){
+				++first1;
+				++first2;
+			}
+			for (auto i = 0; i != 90; ++i){
+				++last1;
+				++last2;
+			}
+			auto ret1 = l1.erase(first1, last1);
+			auto ret2 = l2.erase(first2, last2);
+			assert(*ret1 == *ret2);
+			assert(MINI_STL::Test::container_equal(l1, l2));
+			l2.clear();
+			assert(l2.empty() && l2.begin() == l2.end());
+			l2.push_back(1);
+			assert(l2.front() == 1 && l2.back() == 1);
+		}
+		void testCase5(){
+			//随机插入/删除与std::list对比
+			std::mt19937 gen(7);
+			stdL<int> l1;
+			tsUL<int, 6> l2;
+			for (auto round = 0; round != 5000; ++round){
+				auto pos = l1.empty() ? 0 : gen() % (l1.size() + 1);
+				auto it1 = l1.begin();
+				auto it2 = l2.begin();
+				for (size_t i = 0; i != pos; ++i){
+					++it1;
+					++it2;
+				}
+				if (gen() % 3 != 0 || it1 == l1.end()){
+					it1 = l1.insert(it1, round);
+					it2 = l2.insert(it2, round);
+				}
+				else{
+					it1 = l1.erase(it1);
+					it2 = l2.erase(it2);
+				}
+				assert(it1 == l1.end() ? it2 == l2.end() : *it1 == *it2);
+				assert(l1.size() == l2.size());
+			}
+			assert(MINI_STL::Test::container_equal(l1, l2));
+
+			tsUL<int, 6> l3;
+			l3.swap(l2);
+			assert(l2.empty() && MINI_STL::Test::container_equal(l1, l3));
+		}
+
+		void testCase6(){
+			//结点已满时插入引用本结点元素的值,分裂后仍要插入原值
+			for (size_t pos = 1; pos != 4; ++pos){
+				tsUL<std::string, 4> l1;
+				stdL<std::string> l2;
+				for (auto i = 0; i != 4; ++i){
+					l1.push_back(std::string(40, char('a' + i)));
+					l2.push_back(std::string(40, char('a' + i)));
+				}
+				auto it1 = l1.begin();
+				auto it2 = l2.begin();
+				for (size_t i = 0; i != pos; ++i){
+					++it1;
+					++it2;
+				}
+				it1 = l1.insert(it1, *it1);
+				l2.insert(it2, *it2);
+				assert(*it1 == std::string(40, char('a' + pos)));
+				assert(MINI_STL::Test::container_equal(l1, l2));
+			}
+
+			//元素按T的对齐存放
+			tsUL<double, 4> l3;
+			for (auto i = 0; i != 20; ++i)
+				l3.push_back(i);
+			for (auto it = l3.begin(); it != l3.end(); ++it)
+				assert(reinterpret_cast<size_t>(&*it) % std::alignment_of<double>::value == 0);
+		}
+
+		void testAllCases(){
+			testCase1();
+			testCase2();
+			testCase3();
+			testCase4();
+			testCase5();
+			testCase6();
+			std::cout<<"UnrolledList test ok!"<<std::endl;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef _MINI_STL_UNROLLED_LIST_TEST_H_
+#define _MINI_STL_UNROLLED_LIST_TEST_H_
+
+#include "TestUtil.h"
+
+#include "../Unrolled_list.h"
+#include <list>
+
+#include <cassert>
+#include <string>
+#include <random>
+
+namespace MINI_STL{
+	namespace UnrolledListTest{
+		#define stdL std::list
+		#define tsUL MINI_STL::unrolled_list
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testCase4();
+		void testCase5();
+		void testCase6();
+
+		void testAllCases();
+	}
+}
+
+#endif
\ No newline at end of file
@@ -231,6 +231,73 @@ namespace MINI_STL{
 
 		}
 
+		void testCase16(){
+			tsVec<char> v1(100, MINI_STL::default_init);
+			assert(v1.size() == 100);
+			assert(v1.capacity() == 100);
+
+			const char str[] = "hello world";
+			tsVec<char> v2;
+			v2.append(str, 5);
+			v2.append(str + 5, 6);
+			assert(v2.size() == 11);
+			assert(std::string(v2.begin(), v2.end()) == "hello world");
+			v2.append(v2.data(), 5);
+			assert(std::string(v2.begin(), v2.end()) == "hello worldhello");
+
+			v2.resize_uninitialized(8);
+			assert(std::string(v2.begin(), v2.end()) == "hello wo");
+			v2.resize_default_init(20);
+			assert(v2.size() == 20);
+			v2.resize_uninitialized(1);
+			assert(v2.size() == 1 && v2[0] == 'h');
+
+			tsVec<std::string> v3(3, MINI_STL::default_init);
+			v3.resize_default_init(6);
+			stdVec<std::string> v4(6);
+			assert(MINI_STL::Test::container_equal(v3, v4));
+		}
+
+		void testCase17(){
+			int arr[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+			MINI_STL::list<int> l(std::begin(arr), std::end(arr));
+			MINI_STL::deque<int> d(std::begin(arr), std::end(arr));
+			stdVec<int> v1;
+			tsVec<int> v2;
+
+			v1.insert(v1.end(), std::begin(arr), std::end(arr));
+			v2.append(l.begin(), l.end());
+			assert(MINI_STL::Test::container_equal(v1, v2));
+
+			v1.insert(v1.begin() + 3, std::begin(arr), std::end(arr));
+			v2.insert(v2.begin() + 3, d.begin(), d.end());
+			assert(MINI_STL::Test::container_equal(v1, v2));
+
+			v1.insert(v1.end() - 2, std::begin(arr), std::begin(arr) + 5);
+			v2.insert(v2.end() - 2, std::begin(arr), std::begin(arr) + 5);
+			assert(MINI_STL::Test::container_equal(v1, v2));
+
+			v1.assign(std::begin(arr), std::begin(arr) + 4);
+			v2.assign(l.begin(), l.end());
+			v2.assign(d.begin(), d.begin() + 4);
+			assert(MINI_STL::Test::container_equal(v1, v2));
+
+			v1.assign(5, 7);
+			v2.assign(5, 7);
+			assert(MINI_STL::Test::container_equal(v1, v2));
+
+			v1.insert(v1.begin(), 3, 1);
+			v2.insert(v2.begin(), 3, 1);
+			assert(MINI_STL::Test::container_equal(v1, v2));
+
+			stdVec<std::string> v3(3, "a");
+			tsVec<std::string> v4(3, "a");
+			std::string strs[] = { "x", "y", "z", "w" };
+			v3.insert(v3.begin() + 1, std::begin(strs), std::end(strs));
+			v4.insert(v4.begin() + 1, std::begin(strs), std::end(strs));
+			assert(MINI_STL::Test::container_equal(v3, v4));
+		}
+
 		void testAllCases(){
 			testCase1();
 			testCase2();
@@ -247,6 +314,8 @@ namespace MINI_STL{
 			testCase13();
 			testCase14();
 			testCase15();
+			testCase16();
+			testCase17();
 			std::cout<<"Vector test ok!"<<std::endl;
 		}
 	}
@@ -2,6 +2,8 @@
 #define _MINI_STL_VECTOR_TEST_H_
 
 #include "../Vector.h"
+#include "../List.h"
+#include "../Deque.h"
 #include "TestUtil.h"
 
 #include <vector>
@@ -32,6 +34,8 @@ namespace MINI_STL{
 		void testCase12();
 		void testCase13();
 		void testCase14();
+		void testCase16();
+		void testCase17();
 
 		void testAllCases();
 	}
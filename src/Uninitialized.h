@@ -17,11 +17,19 @@ namespace MINI_STL
 	template<class InputIterator,class ForwardIterator>
 	ForwardIterator _Uninitialized_copy_aux(InputIterator first, InputIterator last,ForwardIterator dest, _true_type)
 	{
-		return copy(first,last,dest);
+		return MINI_STL::copy(first,last,dest);
 	}
 
 	template<class InputIterator,class ForwardIterator>
 	ForwardIterator _Uninitialized_copy_aux(InputIterator first, InputIterator last,ForwardIterator dest, _false_type)
+	{
+		typedef typename segmented_iterator_traits<InputIterator>::is_segmented_iterator in_segmented;
+		typedef typename segmented_iterator_traits<ForwardIterator>::is_segmented_iterator out_segmented;
+		return _Uninitialized_copy_segmented(first,last,dest,in_segmented(),out_segmented());
+	}
+
+	template<class InputIterator,class ForwardIterator>
+	ForwardIterator _Uninitialized_copy_segmented(InputIterator first, InputIterator last,ForwardIterator dest, _false_type, _false_type)
 	{
 		ForwardIterator cur = dest;
 		for(;first!=last;++first,++cur)
@@ -50,6 +58,44 @@ namespace MINI_STL
 		return dest+(last-first);
 	}
 
+	//源为分段迭代器:逐块构造,块内为原生指针
+	template<class SegmentedIterator,class ForwardIterator,class OutSegmented>
+	ForwardIterator _Uninitialized_copy_segmented(SegmentedIterator first, SegmentedIterator last,ForwardIterator dest, _true_type, OutSegmented)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		typename traits::segment_iterator sfirst = traits::segment(first);
+		typename traits::segment_iterator slast = traits::segment(last);
+		if (sfirst==slast)
+		{
+			return MINI_STL::Uninitialized_copy(traits::local(first),traits::local(last),dest);
+		}
+		dest = MINI_STL::Uninitialized_copy(traits::local(first),traits::end(sfirst),dest);
+		for (++sfirst; sfirst!=slast; ++sfirst)
+		{
+			dest = MINI_STL::Uninitialized_copy(traits::begin(sfirst),traits::end(sfirst),dest);
+		}
+		return MINI_STL::Uninitialized_copy(traits::begin(slast),traits::local(last),dest);
+	}
+
+	//目的为分段迭代器:逐个目的块构造,省去每个元素的跨块判断
+	template<class InputIterator,class SegmentedIterator>
+	SegmentedIterator _Uninitialized_copy_segmented(InputIterator first, InputIterator last,SegmentedIterator dest, _false_type, _true_type)
+	{
+		typedef segmented_iterator_traits<SegmentedIterator> traits;
+		while (first!=last)
+		{
+			typename traits::segment_iterator seg = traits::segment(dest);
+			typename traits::local_iterator cur = traits::local(dest);
+			typename traits::local_iterator end = traits::end(seg);
+			for (; first!=last && cur!=end; ++first,++cur)
+			{
+				construct(cur,*first);
+			}
+			dest = traits::compose(seg,cur);
+		}
+		return dest;
+	}
+
 	/************************************************************************/
 	/*	将[first,last)区间内的数据用T填充
 		1.根据数据类型而做不同的填充策略
@@ -84,7 +130,7 @@ namespace MINI_STL
 	template<class ForwardIterator, class Size, class T>
 	ForwardIterator _Uninitialized_fill_n_aux(ForwardIterator first,Size n, const T& x, _true_type)
 	{
-		return fill_n(first, n, x);
+		return MINI_STL::fill_n(first, n, x);
 	}
 
 	template<class ForwardIterator, class Size, class T>
@@ -103,6 +149,36 @@ namespace MINI_STL
 		typedef typename _type_traits<T>::is_POD_type isPODType;
 		return _Uninitialized_fill_n_aux(first, n, x, isPODType());
 	}
+
+	/************************************************************************/
+	/*	从first开始的n个数据块进行默认初始化
+		1.trivial默认构造的类型不做任何处理(内容未初始化)
+		2.其余类型逐个调用默认构造函数
+	*/
+	/************************************************************************/
+	template<class ForwardIterator, class Size>
+	ForwardIterator _Uninitialized_default_n_aux(ForwardIterator first,Size n, _true_type)
+	{
+		advance(first, n);
+		return first;
+	}
+
+	template<class ForwardIterator, class Size>
+	ForwardIterator _Uninitialized_default_n_aux(ForwardIterator first,Size n, _false_type)
+	{
+		for (; n > 0; --n, ++first){
+			construct(&*first);
+		}
+		return first;
+	}
+	//从first开始的n个数据块进行默认初始化,返回尾后迭代器
+	template<class ForwardIterator, class Size>
+	inline ForwardIterator Uninitialized_default_n(ForwardIterator first,Size n)
+	{
+		typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+		typedef typename _type_traits<value_type>::has_trivial_default_constructor trivial;
+		return _Uninitialized_default_n_aux(first, n, trivial());
+	}
 }
 
 #endif
\ No newline at end of file
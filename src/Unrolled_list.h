@@ -0,0 +1,400 @@
+#ifndef _MINI_STL_UNROLLED_LIST_H_
+#define _MINI_STL_UNROLLED_LIST_H_
+
+#include <type_traits>
+#include "Algorithm.h"
+#include "Allocator.h"
+#include "Construct.h"
+#include "Iterator.h"
+#include "Uninitialized.h"
+
+namespace MINI_STL
+{
+	//每个结点的元素个数,k为0时按结点约256字节计算,至少为2以便分裂
+	inline size_t unrolled_list_node_size(size_t size,size_t k)
+	{
+		if (k!=0)
+		{
+			return k<2 ? size_t(2) : k;
+		}
+		return size<128 ? size_t(256/size) : size_t(2);
+	}
+
+	/************************************************************************/
+	/*	unrolled_list:展开链表
+		1.双向循环链表,每个结点存放最多node_size()个连续元素,header结点不存元素
+		2.除header外不存在空结点,遍历时每个结点只需一次跳转
+		3.插入时结点已满则对半分裂;删除后与后继结点合计不超过半满则合并
+		4.插入/删除只会使所在结点(以及被分裂/合并的相邻结点)中的迭代器失效
+	*/
+	/************************************************************************/
+	struct unrolled_list_node
+	{
+		unrolled_list_node* prev;
+		unrolled_list_node* next;
+		size_t count;
+	};
+
+	template<class T,class Ref,class Ptr>
+	struct unrolled_list_iterator
+	{
+		typedef unrolled_list_iterator<T,T&,T*>				iterator;
+		typedef unrolled_list_iterator<T,const T&,const T*>	const_iterator;
+
+		typedef bidirectional_iterator_tag	iterator_category;
+		typedef T							value_type;
+		typedef Ptr							pointer;
+		typedef Ref							reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+		typedef unrolled_list_node			node_type;
+
+		//元素区紧跟在结点头之后,偏移按T的对齐取整;结点内存本身只保证8字节对齐
+		static size_t elements_offset()
+		{
+			const size_t a = std::alignment_of<T>::value;
+			return (sizeof(node_type)+a-1)&~(a-1);
+		}
+		static T* elements(node_type* p)
+		{
+			return reinterpret_cast<T*>(reinterpret_cast<char*>(p)+elements_offset());
+		}
+
+		node_type* node;
+		size_type index;
+
+		unrolled_list_iterator():node(0),index(0){}
+		unrolled_list_iterator(node_type* x,size_type i):node(x),index(i){}
+		unrolled_list_iterator(const iterator& x):node(x.node),index(x.index){}
+
+		reference operator*()const{return elements(node)[index];}
+		pointer operator->()const{return &(operator*());}
+
+		unrolled_list_iterator& operator++()
+		{
+			if (++index==node->count)
+			{
+				node = node->next;
+				index = 0;
+			}
+			return *this;
+		}
+		unrolled_list_iterator operator++(int)
+		{
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+		unrolled_list_iterator& operator--()
+		{
+			if (index==0)
+			{
+				node = node->prev;
+				index = node->count;
+			}
+			--index;
+			return *this;
+		}
+		unrolled_list_iterator operator--(int)
+		{
+			auto temp = *this;
+			--*this;
+			return temp;
+		}
+
+		bool operator==(const unrolled_list_iterator& x)const{return node==x.node && index==x.index;}
+		bool operator!=(const unrolled_list_iterator& x)const{return !(*this==x);}
+	};
+
+	template<class T,size_t K=0>
+	class unrolled_list
+	{
+	public:
+		typedef T							value_type;
+		typedef T*							pointer;
+		typedef T&							reference;
+		typedef const T&					const_reference;
+		typedef size_t						size_type;
+		typedef ptrdiff_t					difference_type;
+
+		typedef unrolled_list_iterator<T,T&,T*>				iterator;
+		typedef unrolled_list_iterator<T,const T&,const T*>	const_iterator;
+
+	protected:
+		typedef unrolled_list_node	node_type;
+		typedef Allocator<char>		byteAllocator;
+
+		//结点经alloc分配,内存池的块只按8字节对齐
+		static_assert(std::alignment_of<T>::value<=8,"unrolled_list: alignment of T must not exceed 8");
+
+		node_type* header;
+		size_type ele_nums;
+
+		static size_type node_size(){return unrolled_list_node_size(sizeof(T),K);}
+		static size_type node_bytes(){return iterator::elements_offset()+sizeof(T)*node_size();}
+		static T* elements(node_type* p){return iterator::elements(p);}
+
+		//在pos之前链入一个空结点
+		node_type* create_node(node_type* pos);
+		void destroy_node(node_type* p);
+		void empty_initialize();
+
+		//在结点p的下标i处插入,要求结点未满
+		void insert_into(node_type* p,size_type i,const T& x);
+		//把p后半部分元素移到新的后继结点
+		void split_node(node_type* p);
+		//把p的后继结点并入p
+		void merge_next(node_type* p);
+
+	public:
+		unrolled_list(){empty_initialize();}
+		template<class InputIterator>
+		unrolled_list(InputIterator first,InputIterator last);
+		unrolled_list(const unrolled_list& x);
+		unrolled_list& operator=(const unrolled_list& x);
+		~unrolled_list();
+
+		iterator begin(){return iterator(header->next,0);}
+		iterator end(){return iterator(header,0);}
+		const_iterator begin()const{return const_iterator(header->next,0);}
+		const_iterator end()const{return const_iterator(header,0);}
+
+		size_type size()const{return ele_nums;}
+		bool empty()const{return ele_nums==0;}
+
+		reference front(){return elements(header->next)[0];}
+		const_reference front()const{return elements(header->next)[0];}
+		reference back(){return elements(header->prev)[header->prev->count-1];}
+		const_reference back()const{return elements(header->prev)[header->prev->count-1];}
+
+		iterator insert(iterator position,const T& x);
+		iterator erase(iterator position);
+		iterator erase(iterator first,iterator last);
+
+		void push_back(const T& x){insert(end(),x);}
+		void push_front(const T& x){insert(begin(),x);}
+		void pop_back(){erase(--end());}
+		void pop_front(){erase(begin());}
+
+		void clear();
+		void swap(unrolled_list& x)
+		{
+			MINI_STL::swap(header,x.header);
+			MINI_STL::swap(ele_nums,x.ele_nums);
+		}
+	};
+
+	template<class T,size_t K>
+	typename unrolled_list<T,K>::node_type* unrolled_list<T,K>::create_node(node_type* pos)
+	{
+		node_type* p = reinterpret_cast<node_type*>(byteAllocator::allocate(node_bytes()));
+		p->count = 0;
+		p->next = pos;
+		p->prev = pos->prev;
+		pos->prev->next = p;
+		pos->prev = p;
+		return p;
+	}
+
+	template<class T,size_t K>
+	void unrolled_list<T,K>::destroy_node(node_type* p)
+	{
+		destroy(elements(p),elements(p)+p->count);
+		p->prev->next = p->next;
+		p->next->prev = p->prev;
+		byteAllocator::deallocate(reinterpret_cast<char*>(p),node_bytes());
+	}
+
+	template<class T,size_t K>
+	void unrolled_list<T,K>::empty_initialize()
+	{
+		header = reinterpret_cast<node_type*>(byteAllocator::allocate(sizeof(node_type)));
+		header->prev = header;
+		header->next = header;
+		header->count = 0;
+		ele_nums = 0;
+	}
+
+	template<class T,size_t K>
+	template<class InputIterator>
+	unrolled_list<T,K>::unrolled_list(InputIterator first,InputIterator last)
+	{
+		empty_initialize();
+		for (; first != last; ++first)
+		{
+			push_back(*first);
+		}
+	}
+
+	template<class T,size_t K>
+	unrolled_list<T,K>::unrolled_list(const unrolled_list& x)
+	{
+		empty_initialize();
+		for (const_iterator it = x.begin(); it != x.end(); ++it)
+		{
+			push_back(*it);
+		}
+	}
+
+	template<class T,size_t K>
+	unrolled_list<T,K>& unrolled_list<T,K>::operator=(const unrolled_list& x)
+	{
+		if (this!=&x)
+		{
+			unrolled_list temp(x);
+			swap(temp);
+		}
+		return *this;
+	}
+
+	template<class T,size_t K>
+	unrolled_list<T,K>::~unrolled_list()
+	{
+		clear();
+		byteAllocator::deallocate(reinterpret_cast<char*>(header),sizeof(node_type));
+	}
+
+	template<class T,size_t K>
+	void unrolled_list<T,K>::insert_into(node_type* p,size_type i,const T& x)
+	{
+		T* e = elements(p);
+		if (i==p->count)
+		{
+			construct(e+i,x);
+		}
+		else
+		{
+			T x_copy = x;
+			construct(e+p->count,e[p->count-1]);
+			MINI_STL::copy_backward(e+i,e+p->count-1,e+p->count);
+			e[i] = x_copy;
+		}
+		++p->count;
+		++ele_nums;
+	}
+
+	template<class T,size_t K>
+	void unrolled_list<T,K>::split_node(node_type* p)
+	{
+		node_type* q = create_node(p->next);
+		const size_type half = p->count/2;
+		T* e = elements(p);
+		Uninitialized_copy(e+half,e+p->count,elements(q));
+		destroy(e+half,e+p->count);
+		q->count = p->count-half;
+		p->count = half;
+	}
+
+	template<class T,size_t K>
+	void unrolled_list<T,K>::merge_next(node_type* p)
+	{
+		node_type* q = p->next;
+		Uninitialized_copy(elements(q),elements(q)+q->count,elements(p)+p->count);
+		p->count += q->count;
+		destroy_node(q);
+	}
+
+	template<class T,size_t K>
+	typename unrolled_list<T,K>::iterator unrolled_list<T,K>::insert(iterator position,const T& x)
+	{
+		node_type* p = position.node;
+		size_type i = position.index;
+		if (p==header)
+		{
+			//尾部插入:填满最后一个结点后再开新结点,不做分裂
+			p = header->prev;
+			if (p==header || p->count==node_size())
+			{
+				p = create_node(header);
+			}
+			i = p->count;
+		}
+		else if (p->count==node_size())
+		{
+			if (i==0)
+			{
+				//结点首部插入:优先放到前驱结点的末尾
+				p = p->prev;
+				if (p==header || p->count==node_size())
+				{
+					p = create_node(position.node);
+				}
+				i = p->count;
+			}
+			else
+			{
+				//分裂会析构后半部分元素,x可能引用其中之一,先拷贝
+				T x_copy = x;
+				split_node(p);
+				if (i>p->count)
+				{
+					i -= p->count;
+					p = p->next;
+				}
+				insert_into(p,i,x_copy);
+				return iterator(p,i);
+			}
+		}
+		insert_into(p,i,x);
+		return iterator(p,i);
+	}
+
+	template<class T,size_t K>
+	typename unrolled_list<T,K>::iterator unrolled_list<T,K>::erase(iterator position)
+	{
+		node_type* p = position.node;
+		const size_type i = position.index;
+		T* e = elements(p);
+		MINI_STL::copy(e+i+1,e+p->count,e+i);
+		destroy(e+p->count-1);
+		--p->count;
+		--ele_nums;
+		if (p->count==0)
+		{
+			node_type* next = p->next;
+			destroy_node(p);
+			return iterator(next,0);
+		}
+		if (p->next!=header && p->count+p->next->count<=node_size()/2)
+		{
+			merge_next(p);
+		}
+		return i<p->count ? iterator(p,i) : iterator(p->next,0);
+	}
+
+	template<class T,size_t K>
+	typename unrolled_list<T,K>::iterator unrolled_list<T,K>::erase(iterator first,iterator last)
+	{
+		//合并结点会使last失效,先数出个数
+		size_type n = MINI_STL::distance(first,last);
+		while (n--)
+		{
+			first = erase(first);
+		}
+		return first;
+	}
+
+	template<class T,size_t K>
+	void unrolled_list<T,K>::clear()
+	{
+		while (header->next!=header)
+		{
+			destroy_node(header->next);
+		}
+		ele_nums = 0;
+	}
+
+	template<class T,size_t K>
+	inline bool operator==(const unrolled_list<T,K>& x,const unrolled_list<T,K>& y)
+	{
+		return x.size()==y.size() && MINI_STL::equal(x.begin(),x.end(),y.begin());
+	}
+
+	template<class T,size_t K>
+	inline bool operator!=(const unrolled_list<T,K>& x,const unrolled_list<T,K>& y)
+	{
+		return !(x==y);
+	}
+}
+
+#endif
@@ -9,6 +9,10 @@
 
 namespace MINI_STL
 {
+	//Ĭϳʼ,trivial͵
+	struct default_init_t {};
+	const default_init_t default_init = default_init_t();
+
 	template<class T,class Alloc=Allocator<T>>
 	class vector
 	{
@@ -46,10 +50,22 @@ namespace MINI_STL
 			Uninitialized_fill_n(dest,n,x);
 			return dest;
 		}
+		//ͳʼ:InputIterator,ForwardIteratorһԷ
 		template<class InputIterator>
-		void allocate_and_copy(InputIterator first, InputIterator last){
-			start = dataAllocator::allocate(last - first);
-			finish = Uninitialized_copy(first, last, start);
+		void range_initialize(InputIterator first,InputIterator last,input_iterator_tag)
+		{
+			start = finish = end_of_storage = 0;
+			for (;first!=last;++first)
+			{
+				push_back(*first);
+			}
+		}
+		template<class ForwardIterator>
+		void range_initialize(ForwardIterator first,ForwardIterator last,forward_iterator_tag)
+		{
+			const size_type n = MINI_STL::distance(first,last);
+			start = allocate_and_copy(n,first,last);
+			finish = start+n;
 			end_of_storage = finish;
 		}
 		template<class InputIterator>
@@ -65,6 +81,47 @@ namespace MINI_STL
 			finish = start+n;
 			end_of_storage = finish;
 		}
+		//ڴ沢Ĭϳʼ&¿ռ״̬
+		void default_initialize(size_type n)
+		{
+			start = dataAllocator::allocate(n);
+			finish = Uninitialized_default_n(start,n);
+			end_of_storage = start+n;
+		}
+		//֤βٻnԪ,insertĲ
+		void grow_for(size_type n)
+		{
+			if (size_type(end_of_storage-finish)<n)
+			{
+				const size_type old_size = size();
+				reserve(old_size+max(old_size,n));
+			}
+		}
+
+		//
+		template<class Integer>
+		void insert_dispatch(iterator position,Integer n,Integer x,_true_type){insert(position,size_type(n),T(x));}
+		template<class InputIterator>
+		void insert_dispatch(iterator position,InputIterator first,InputIterator last,_false_type)
+		{
+			range_insert(position,first,last,iterator_category(first));
+		}
+		template<class InputIterator>
+		void range_insert(iterator position,InputIterator first,InputIterator last,input_iterator_tag);
+		template<class ForwardIterator>
+		void range_insert(iterator position,ForwardIterator first,ForwardIterator last,forward_iterator_tag);
+
+		template<class Integer>
+		void assign_dispatch(Integer n,Integer x,_true_type){assign(size_type(n),T(x));}
+		template<class InputIterator>
+		void assign_dispatch(InputIterator first,InputIterator last,_false_type)
+		{
+			range_assign(first,last,iterator_category(first));
+		}
+		template<class InputIterator>
+		void range_assign(InputIterator first,InputIterator last,input_iterator_tag);
+		template<class ForwardIterator>
+		void range_assign(ForwardIterator first,ForwardIterator last,forward_iterator_tag);
 
 	public:
 		//캯
@@ -74,8 +131,9 @@ namespace MINI_STL
 		vector(int n,const T& value){fill_initialize(n,value);}
 		vector(long n,const T& value){fill_initialize(n,value);}
 		explicit vector(size_type n){fill_initialize(n,T());}
+		vector(size_type n,default_init_t){default_initialize(n);}
 		template<class InputIterator>
-		vector(InputIterator first,InputIterator last){allocate_and_copy(first,last);}
+		vector(InputIterator first,InputIterator last){range_initialize(first,last,iterator_category(first));}
 		//
 		~vector()
 		{
@@ -153,51 +211,35 @@ namespace MINI_STL
 
 		void insert(iterator position,size_type n,const T& x);
 		void insert(iterator position,const T& x);
-		//template <class InputIterator>
-		void insert(iterator position,iterator first,iterator last)
-		{
-			if (first != last) {
-				size_type n = last-first;
-				if (size_type(end_of_storage - finish) >= n) {
-					const size_type elems_after = finish - position;
-					iterator old_finish = finish;
-					if (elems_after > n) {
-						Uninitialized_copy(finish - n, finish, finish);
-						finish += n;
-						copy_backward(position, old_finish - n, old_finish);
-						copy(first, last, position);
-					}
-					else {
-						Uninitialized_copy(first + elems_after, last, finish);
-						finish += n - elems_after;
-						Uninitialized_copy(position, old_finish, finish);
-						finish += elems_after;
-						copy(first, first + elems_after, position);
-					}
-				}
-				else {
-					const size_type old_size = size();
-					const size_type len = old_size + max(old_size, n);
-					iterator new_start = dataAllocator::allocate(len);
-					iterator new_finish = new_start;
-					new_finish = Uninitialized_copy(start, position, new_start);
-					new_finish = Uninitialized_copy(first, last, new_finish);
-					new_finish = Uninitialized_copy(position, finish, new_finish);
-					
-					destroy(start, finish);
-					deallocate();
-					start = new_start;
-					finish = new_finish;
-					end_of_storage = new_start + len;
-				}
-			}
+		//:ForwardIteratorֻһξ벢һ
+		template<class InputIterator>
+		void insert(iterator position,InputIterator first,InputIterator last)
+		{
+			typedef typename _is_Integer<InputIterator>::_Integral _Integral;
+			insert_dispatch(position,first,last,_Integral());
+		}
+
+		//β׷
+		template<class InputIterator>
+		void append(InputIterator first,InputIterator last)
+		{
+			insert(end(),first,last);
+		}
+
+		//¸ֵ
+		void assign(size_type n,const T& x);
+		template<class InputIterator>
+		void assign(InputIterator first,InputIterator last)
+		{
+			typedef typename _is_Integer<InputIterator>::_Integral _Integral;
+			assign_dispatch(first,last,_Integral());
 		}
 
 		iterator erase(iterator position)
 		{
 			if (position+1!=end())  //ԪǰƣĽ
 			{
-				copy(position+1,finish,position);
+				MINI_STL::copy(position+1,finish,position);
 			}
 			--finish;
 			destroy(finish);
@@ -206,7 +248,7 @@ namespace MINI_STL
 
 		iterator erase(iterator first,iterator last)
 		{
-			iterator i = copy(last,finish,first);
+			iterator i = MINI_STL::copy(last,finish,first);
 			destroy(i,finish);
 			finish = finish-(last-first);
 			return first;
@@ -229,6 +271,41 @@ namespace MINI_STL
 			resize(new_size,T());
 		}
 
+		//ĬϳʼԪ,trivialͲ
+		void resize_default_init(size_type new_size)
+		{
+			if (new_size<size())
+			{
+				erase(begin()+new_size,end());
+			}
+			else
+			{
+				grow_for(new_size-size());
+				finish = Uninitialized_default_n(finish,new_size-size());
+			}
+		}
+
+		void resize_uninitialized(size_type new_size)
+		{
+			resize_default_init(new_size);
+		}
+
+		//β׷[p,p+n),ֻһ,trivialֱmemmove
+		void append(const T* p,size_type n)
+		{
+			if (p>=start&&p<finish)   //Դλڲ
+			{
+				const size_type offset = p-start;
+				grow_for(n);
+				p = start+offset;
+			}
+			else
+			{
+				grow_for(n);
+			}
+			finish = Uninitialized_copy(p,p+n,finish);
+		}
+
 		void clear()             //Ԫȫ
 		{
 			erase(begin(),end());
@@ -343,14 +420,14 @@ namespace MINI_STL
 				{
 					Uninitialized_copy(finish-n,finish,finish);
 					finish = finish+n;
-					copy_backward(position,old_finish-n,old_finish);
-					fill(position,position+n,copy_x);
+					MINI_STL::copy_backward(position,old_finish-n,old_finish);
+					MINI_STL::fill(position,position+n,copy_x);
 				}
 				else 
 				{
 					finish = Uninitialized_fill_n(finish,n-elems_after,copy_x);
 					finish = Uninitialized_copy(position,old_finish,finish);
-					fill(position,old_finish,copy_x);
+					MINI_STL::fill(position,old_finish,copy_x);
 				}
 			}
 			//2.ʣռݲҪԪ
@@ -380,6 +457,140 @@ namespace MINI_STL
 		insert(position,1,x);
 	}
 
+	template<class T,class Alloc>
+	template<class InputIterator>
+	void vector<T,Alloc>::range_insert(iterator position,InputIterator first,InputIterator last,input_iterator_tag)
+	{
+		//βֱpush_back(),ռٰForwardIterator
+		if (position==end())
+		{
+			for (;first!=last;++first)
+			{
+				push_back(*first);
+			}
+		}
+		else
+		{
+			vector<T,Alloc> temp(first,last);
+			range_insert(position,temp.begin(),temp.end(),forward_iterator_tag());
+		}
+	}
+
+	template<class T,class Alloc>
+	template<class ForwardIterator>
+	void vector<T,Alloc>::range_insert(iterator position,ForwardIterator first,ForwardIterator last,forward_iterator_tag)
+	{
+		if (first!=last)
+		{
+			const size_type n = MINI_STL::distance(first,last);
+			//1.ʣռڵҪԪ
+			if (size_type(end_of_storage-finish)>=n)
+			{
+				const size_type elems_after = finish-position;
+				iterator old_finish = finish;
+				if (elems_after>n)
+				{
+					Uninitialized_copy(finish-n,finish,finish);
+					finish += n;
+					MINI_STL::copy_backward(position,old_finish-n,old_finish);
+					MINI_STL::copy(first,last,position);
+				}
+				else
+				{
+					ForwardIterator mid = first;
+					MINI_STL::advance(mid,elems_after);
+					finish = Uninitialized_copy(mid,last,finish);
+					finish = Uninitialized_copy(position,old_finish,finish);
+					MINI_STL::copy(first,mid,position);
+				}
+			}
+			//2.ʣռ䲻㣬һη䵽λ
+			else
+			{
+				const size_type old_size = size();
+				const size_type len = old_size+max(old_size,n);
+				iterator new_start = dataAllocator::allocate(len);
+				iterator new_finish = new_start;
+				new_finish = Uninitialized_copy(start,position,new_start);
+				new_finish = Uninitialized_copy(first,last,new_finish);
+				new_finish = Uninitialized_copy(position,finish,new_finish);
+
+				destroy(start,finish);
+				deallocate();
+				start = new_start;
+				finish = new_finish;
+				end_of_storage = new_start+len;
+			}
+		}
+	}
+
+	template<class T,class Alloc>
+	void vector<T,Alloc>::assign(size_type n,const T& x)
+	{
+		if (n>capacity())
+		{
+			vector<T,Alloc> temp(n,x);
+			swap(temp);
+		}
+		else if (n>size())
+		{
+			MINI_STL::fill(begin(),end(),x);
+			finish = Uninitialized_fill_n(finish,n-size(),x);
+		}
+		else
+		{
+			erase(MINI_STL::fill_n(begin(),n,x),end());
+		}
+	}
+
+	template<class T,class Alloc>
+	template<class InputIterator>
+	void vector<T,Alloc>::range_assign(InputIterator first,InputIterator last,input_iterator_tag)
+	{
+		iterator cur = begin();
+		for (;first!=last&&cur!=end();++first,++cur)
+		{
+			*cur = *first;
+		}
+		if (first==last)
+		{
+			erase(cur,end());
+		}
+		else
+		{
+			range_insert(end(),first,last,input_iterator_tag());
+		}
+	}
+
+	template<class T,class Alloc>
+	template<class ForwardIterator>
+	void vector<T,Alloc>::range_assign(ForwardIterator first,ForwardIterator last,forward_iterator_tag)
+	{
+		const size_type len = MINI_STL::distance(first,last);
+		if (len>capacity())
+		{
+			iterator temp = allocate_and_copy(len,first,last);
+			destroy(start,finish);
+			deallocate();
+			start = temp;
+			finish = temp+len;
+			end_of_storage = finish;
+		}
+		else if (len<=size())
+		{
+			iterator new_finish = MINI_STL::copy(first,last,start);
+			destroy(new_finish,finish);
+			finish = new_finish;
+		}
+		else
+		{
+			ForwardIterator mid = first;
+			MINI_STL::advance(mid,size());
+			MINI_STL::copy(first,mid,start);
+			finish = Uninitialized_copy(mid,last,finish);
+		}
+	}
+
 	template<class T,class Alloc>
 	void vector<T,Alloc>::insert_aux(iterator position,const T& x)
 	{
@@ -5,14 +5,17 @@
 #include "Profiler\Profiler.h"
 #include "Test\VectorTest.h"
 #include "Test\ListTest.h"
+#include "Test\UnrolledListTest.h"
 #include "Test\DequeTest.h"
 #include "Test\StackTest.h"
+#include "Test\CircularBufferTest.h"
 #include "Test\PriorityQueueTest.h"
 #include <forward_list>
 #include "Slist.h"
 #include "Vector.h"
 #include "Test\BasicTest.h" 
 #include "Test\AlgorithmTest.h"
+#include "Test\PerformanceTest.h"
 
 using namespace MINI_STL::Profiler;
 
@@ -22,10 +25,11 @@ int main(){
 	//MINI_STL::AVLTreeTest::testAllCases();
 	//MINI_STL::BitmapTest::testAllCases();
 	//MINI_STL::BinarySearchTreeTest::testAllCases();
-	//MINI_STL::CircularBufferTest::testAllCases();
+	MINI_STL::CircularBufferTest::testAllCases();
 	//MINI_STL::COWPtrTest::testAllCases();
 	MINI_STL::DequeTest::testAllCases();
 	MINI_STL::ListTest::testAllCases();
+	MINI_STL::UnrolledListTest::testAllCases();
 	//MINI_STL::GraphTest::testAllCases();
 	//MINI_STL::PairTest::testAllCases();
 	MINI_STL::PriorityQueueTest::testAllCases();
@@ -43,6 +47,7 @@ int main(){
 	MINI_STL::VectorTest::testAllCases();
 	MINI_STL::BasicTest::testAllCases();
 	MINI_STL::AlgorithmTest::testAllCases();
+	//MINI_STL::PerformanceTest::testAllCases();
 	system("pause");
 	return 0;
 }